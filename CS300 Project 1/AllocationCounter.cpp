@@ -0,0 +1,39 @@
+//=========================================================================
+// Name        : AllocationCounter.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Heap allocation count for instrumented benchmark builds
+//=========================================================================
+
+#include "AllocationCounter.h"
+
+#ifdef COURSE_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib> // For std::malloc and std::free
+#include <new>     // For std::bad_alloc
+
+// The replacements live in their own file so no caller sees that they are malloc and free.
+// new[] and delete[] go through these as well.
+static std::atomic<std::size_t> allocations(0);
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* block = std::malloc(size == 0 ? 1 : size)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+std::size_t HeapAllocations() {
+    return allocations.load();
+}
+#endif
@@ -0,0 +1,21 @@
+//=========================================================================
+// Name        : AllocationCounter.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Heap allocation count for instrumented benchmark builds
+//=========================================================================
+
+#pragma once
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+#ifdef COURSE_COUNT_ALLOCATIONS
+// build with COURSE_COUNT_ALLOCATIONS defined to replace operator new with one that counts
+// every heap allocation, --bench-lookups reports them per lookup
+std::size_t HeapAllocations(); // allocations since the program started
+#endif
+
+#endif // ALLOCATIONCOUNTER_H
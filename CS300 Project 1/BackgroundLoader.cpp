@@ -0,0 +1,176 @@
+//=========================================================================
+// Name        : BackgroundLoader.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Loads a courses file on background threads, answering lookups as it goes
+//=========================================================================
+
+#include "BackgroundLoader.h"
+#include "CaseFold.h"
+
+#include <algorithm> // For std::lower_bound and std::max
+
+// Constructor.
+BackgroundLoader::BackgroundLoader()
+    : target(nullptr), fileSource(), nextSlice(0), slicesLeft(0), built(false), cancelled(false), parsedCount(0),
+      builtSeconds(0.0), firstAnswerSeconds(-1.0), rowCount(0) {}
+
+// Destructor.
+BackgroundLoader::~BackgroundLoader() {
+    cancel();
+    finish();
+}
+
+// Start loading filename into bst, which must be empty and left alone until finish().
+// Returns false if the file can't be read or mapped.
+bool BackgroundLoader::start(BinarySearchTree& bst, const std::string& filename) {
+    finish();
+    if (!SnapshotSource::of(filename, fileSource) || !file.open(filename)) {
+        return false;
+    }
+    started = std::chrono::steady_clock::now();
+    firstAnswerSeconds = -1.0;
+    builtSeconds = 0.0;
+    rowCount = 0;
+    built = false;
+    cancelled = false;
+    parsedCount = 0;
+
+    std::string_view text = file.view();
+    slices = SliceText(text, std::max<std::size_t>(1, text.size() / SLICE_BYTES));
+    chunks = std::vector<ParsedChunk>(slices.size());
+    parsed.reset(new std::atomic<bool>[slices.size()]);
+    for (std::size_t i = 0; i < slices.size(); ++i) {
+        parsed[i] = false;
+    }
+    nextSlice = 0;
+    slicesLeft = slices.size();
+    target = &bst;
+
+    if (slices.empty()) { // an empty file, there is nothing to wait for
+        built.store(true, std::memory_order_release);
+        return true;
+    }
+    std::size_t threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min(threads, slices.size());
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(&BackgroundLoader::parseSlices, this);
+    }
+    return true;
+}
+
+// Worker thread: parse slices in file order until none are left. The one that finishes the last slice builds the tree.
+void BackgroundLoader::parseSlices() {
+    while (!cancelled.load(std::memory_order_relaxed)) {
+        std::size_t slice = nextSlice.fetch_add(1);
+        if (slice >= slices.size()) return;
+        ParseChunk(slices[slice], chunks[slice]);
+        parsed[slice].store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            ++parsedCount;
+        }
+        progress.notify_all();
+        if (slicesLeft.fetch_sub(1) == 1) {
+            buildTree();
+            return;
+        }
+    }
+}
+
+// Merge every slice and build the tree from the sorted rows, the same as a parallel load.
+// The slices are only read, so lookups keep answering from them meanwhile.
+void BackgroundLoader::buildTree() {
+    std::size_t rows = 0;
+    std::vector<CourseFields> sorted = MergeChunks(chunks, rows);
+    if (cancelled) return;
+    if (!target->buildSorted(sorted)) { // the tree already has courses, so add the rows one at a time
+        std::vector<std::string_view> prerequisites;
+        for (const CourseFields& row : sorted) {
+            prerequisites.assign(row.prerequisites, row.prerequisites + row.prerequisiteCount);
+            target->emplace(row.courseNumber, row.title, prerequisites);
+        }
+    }
+    target->compact(); // lay the loaded nodes out in tree order
+    target->freeze(); // and compile the flat lookup array
+    rowCount = rows;
+    builtSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    built.store(true, std::memory_order_release);
+}
+
+// Binary search one parsed slice. A stable sort kept duplicates in file order, so the first one wins.
+bool BackgroundLoader::searchSlice(std::size_t slice, std::string_view courseNumber, CourseFields& row) const {
+    const std::vector<CourseFields>& rows = chunks[slice].rows;
+    auto it = std::lower_bound(rows.begin(), rows.end(), courseNumber,
+        [](const CourseFields& a, std::string_view key) { return a.courseNumber < key; });
+    if (it == rows.end() || it->courseNumber != courseNumber) {
+        return false;
+    }
+    row = *it;
+    return true;
+}
+
+// Look a course up in the slices parsed so far, then in each slice as it gets parsed. A hit only counts once
+// every slice before it was searched too, so a number listed twice answers with its first row in file order,
+// the one the merged tree keeps. Returns false once every slice was searched without finding it.
+bool BackgroundLoader::find(std::string_view courseNumber, CourseFields& row) {
+    FoldedKey key(courseNumber);
+    std::vector<bool> searched(slices.size(), false);
+    std::size_t hitSlice = slices.size(); // earliest slice holding the course so far
+    std::size_t searchedPrefix = 0;       // slices before this one were all searched
+    while (true) {
+        std::size_t seenParsed;
+        {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            seenParsed = parsedCount;
+        }
+        for (std::size_t i = searchedPrefix; i < hitSlice; ++i) { // slices after a hit can't change the answer
+            if (searched[i] || !parsed[i].load(std::memory_order_acquire)) continue;
+            searched[i] = true;
+            CourseFields candidate;
+            if (searchSlice(i, key.view(), candidate)) {
+                hitSlice = i;
+                row = candidate;
+            }
+        }
+        while (searchedPrefix < hitSlice && searched[searchedPrefix]) {
+            ++searchedPrefix;
+        }
+        if (searchedPrefix == hitSlice) break; // nothing earlier is left, or nothing at all when there was no hit
+
+        // wait until another slice is parsed
+        std::unique_lock<std::mutex> lock(progressMutex);
+        progress.wait(lock, [&]() { return parsedCount > seenParsed || cancelled.load(); });
+        if (cancelled) return false;
+    }
+    if (firstAnswerSeconds < 0.0) {
+        firstAnswerSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+    return hitSlice < slices.size();
+}
+
+// Wait for the tree to be built and release the slices. The tree is the caller's again afterwards.
+bool BackgroundLoader::finish() {
+    if (target == nullptr) return false;
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    bool success = built.load() && !cancelled.load();
+    chunks.clear();
+    slices.clear();
+    parsed.reset();
+    file.close();
+    target = nullptr;
+    return success;
+}
+
+// Stop taking new slices and wake any lookup that is waiting for one.
+void BackgroundLoader::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(progressMutex);
+        cancelled = true;
+    }
+    progress.notify_all();
+}
@@ -0,0 +1,87 @@
+//=========================================================================
+// Name        : BackgroundLoader.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Loads a courses file on background threads, answering lookups as it goes
+//=========================================================================
+
+#pragma once
+#ifndef BACKGROUNDLOADER_H
+#define BACKGROUNDLOADER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "BinarySearchTree.h"
+#include "CourseParser.h"
+#include "MappedFile.h"
+
+// BackgroundLoader lets the planner answer lookups while a large file is still loading.
+// The mapped file is cut into slices of about SLICE_BYTES, and worker threads parse them
+// in file order. Each slice is sorted and published as soon as it is parsed, so find()
+// answers a course from the slices read so far and only waits while a slice before the
+// first one holding it is still being parsed. The worker that parses the last slice merges them all and builds the
+// tree the way a parallel load does. The tree belongs to the loader until finish().
+class BackgroundLoader {
+public:
+    static constexpr std::size_t SLICE_BYTES = 1 << 20;
+
+private:
+    BinarySearchTree* target; // null when no load is running
+    MappedFile file;
+    SnapshotSource fileSource; // size and time of the file before it was read
+    std::vector<std::string_view> slices;
+    std::vector<ParsedChunk> chunks;
+    std::unique_ptr<std::atomic<bool>[]> parsed; // slice i is parsed, sorted and may be searched
+    std::atomic<std::size_t> nextSlice;  // next slice a worker takes
+    std::atomic<std::size_t> slicesLeft; // slices still being parsed
+    std::atomic<bool> built;
+    std::atomic<bool> cancelled;
+    std::mutex progressMutex;
+    std::condition_variable progress; // signalled after every slice
+    std::size_t parsedCount;          // guarded by progressMutex
+    std::vector<std::thread> workers;
+
+    std::chrono::steady_clock::time_point started;
+    std::atomic<double> builtSeconds;
+    double firstAnswerSeconds; // -1 until find() first answered
+    std::size_t rowCount;
+
+    void parseSlices();
+    void buildTree();
+    bool searchSlice(std::size_t slice, std::string_view courseNumber, CourseFields& row) const;
+
+public:
+    BackgroundLoader(); // constructor
+    ~BackgroundLoader(); // destructor, cancels a running load
+
+    BackgroundLoader(const BackgroundLoader&) = delete;
+    BackgroundLoader& operator=(const BackgroundLoader&) = delete;
+
+    bool start(BinarySearchTree& bst, const std::string& filename);
+    bool isLoading() const { return target != nullptr; }
+    bool isReady() const { return built.load(std::memory_order_acquire); }
+
+    // look a course up in the rows loaded so far, waiting for earlier slices while they are
+    // still parsing, the row is the first in file order and stays valid until finish()
+    bool find(std::string_view courseNumber, CourseFields& row);
+
+    bool finish(); // wait for the tree and hand it back, false if the load failed or was cancelled
+    void cancel(); // stop parsing, finish() then returns false
+
+    // metrics of the last load, read after finish()
+    std::size_t rows() const { return rowCount; }
+    double loadSeconds() const { return builtSeconds.load(); }
+    double firstAnswer() const { return firstAnswerSeconds; } // seconds from start() to the first lookup answered, -1 if none
+    const SnapshotSource& source() const { return fileSource; } // the file as start() found it, for the snapshot
+};
+
+#endif // BACKGROUNDLOADER_H
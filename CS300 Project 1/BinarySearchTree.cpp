@@ -1,130 +1,733 @@
-//=========================================================================
-// Name        : BinarySearchTree.cpp
-// Author      : John St Hilaire
-// Version     : 1.0
-// Last Updated : 2/25/23
-// Description : Binary Search Tree class implementation for Project 1 for CS300 at SNHU
-//=========================================================================
-
-#include "BinarySearchTree.h"
-
-// Insert a new course into the BST.
-TreeNode* BinarySearchTree::insertCourse(TreeNode* node, Course newCourse) {
-    // if the current node is null, create a new treenode with the course
-    if (node == nullptr) {
-        return new TreeNode(newCourse);
-    }
-    // if the course number is less than the current node's, insert to the left
-    if (newCourse.courseNumber < node->course.courseNumber) {
-        node->left = insertCourse(node->left, newCourse);
-    }
-    // if the course number is greater than the current node's, insert to the right
-    else if (newCourse.courseNumber > node->course.courseNumber) {
-        node->right = insertCourse(node->right, newCourse);
-    }
-
-    return node; // return the node pointer
-}
-
-// Print course details.
-void BinarySearchTree::printCourseDetails(TreeNode* node) const {
-    if (node == nullptr) return; // if the node is null, return
-    std::cout << "\nCourse Number: " << node->course.courseNumber << std::endl; // output the course number
-    std::cout << "Title: " << node->course.title << std::endl; // output the course title
-    std::cout << "Prerequisites: "; // handle the prerequisites list
-    if (node->course.prerequisites.empty()) { // if there are no prerequisites, print 'none'
-        std::cout << "None\n";
-    }
-    else { // else print each prerequisite
-        for (const std::string& prereq : node->course.prerequisites) {
-            std::cout << prereq << " ";
-        }
-    }
-    std::cout << std::endl; // end the line after printing prerequisites
-}
-
-// In-order traversal to print all courses.
-void BinarySearchTree::inOrderTraversal(TreeNode* node) const {
-    if (node == nullptr) return; // if the current node is null, return to the previous level of recursion
-    inOrderTraversal(node->left); // visit the left subtree
-    std::cout << node->course.courseNumber << ", " << node->course.title << std::endl; // print info on individual course
-    inOrderTraversal(node->right); // visit the right subtree
-}
-
-// Find a course by course number.
-TreeNode* BinarySearchTree::findCourse(TreeNode* node, const std::string& courseNumber) const {
-    
-    std::string courseNum = toUpperCase(courseNumber); // convert the input course number to uppercase
-
-
-    if (node == nullptr || node->course.courseNumber == courseNum) { // if the node is null or the node's course number matches the search term, return the node
-        return node;
-    }
-
-    if (courseNum < node->course.courseNumber) { // if the search term is less than the node's course number, search in the left subtree
-        return findCourse(node->left, courseNum);
-    }
-    else { // if the search term is greater than the node's course number, search in the right subtree
-        return findCourse(node->right, courseNum);
-    }
-}
-
-// Helper function to convert a string to uppercase for case-insensitive comparison
-// source: cppreference.com/std/algorithm/transform
-std::string BinarySearchTree::toUpperCase(const std::string& str) const {
-    std::string upperStr;
-    upperStr.reserve(str.length()); // reserve memory to avoid reallocations
-    std::transform(str.begin(), str.end(), std::back_inserter(upperStr), ::toupper); // convert each character in the string to uppercase
-    return upperStr; // return the uppercase string
-}
-
-//  Recursively delete all nodes.
-void BinarySearchTree::deleteAllNodes(TreeNode* node) {
-    if (node) { // check if the current node exists
-        deleteAllNodes(node->left); // recursively delete all nodes in the left subtree
-        deleteAllNodes(node->right); // recursively delete all nodes in the right subtree
-        delete node; // delete the current node after its children have been deleted
-    }
-}
-
-// Constructor.
-BinarySearchTree::BinarySearchTree() : root(nullptr) {}
-
-// Check if the tree is empty.
-bool BinarySearchTree::isEmpty() const {
-    return root == nullptr; // return true if root is null, indicating the tree has no nodes
-}
-
-// Insert a new course into the BST.
-void BinarySearchTree::insert(Course newCourse) {
-    root = insertCourse(root, newCourse); // call the insertCourse helper function, starting at the root, to insert the new course
-}
-
-// Print details of a single course.
-void BinarySearchTree::printCourse(const std::string& courseNumber) const {
-    TreeNode* courseNode = findCourse(root, courseNumber); // find the course in the bst using the findcourse helper function
-    if (courseNode != nullptr) { // if the course was found, print its details
-        printCourseDetails(courseNode);
-    }
-    else { // if the course was not found, print a message indicating so
-        std::cout << "Course not found." << std::endl;
-    }
-}
-
-
-
-// Print all courses in the BST.
-void BinarySearchTree::printAllCourses() const {
-    if (isEmpty()) { // check if the bst is empty before trying to print
-        std::cout << "The tree is empty." << std::endl;
-        return;
-    }
-    std::cout << std::endl;
-    inOrderTraversal(root); // perform an in-order traversal to print all courses
-    std::cout << std::endl;
-}
-
-// Destructor.
-BinarySearchTree::~BinarySearchTree() {
-    deleteAllNodes(root); // call the deleteallnodes helper function to delete all nodes starting from the root
-}
+//=========================================================================
+// Name        : BinarySearchTree.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 2/25/23
+// Description : Binary Search Tree class implementation for Project 1 for CS300 at SNHU
+//=========================================================================
+
+#include "BinarySearchTree.h"
+#include "CourseExporter.h"
+#include <cstdio> // For the stdout the exporter writes to
+
+// Insert a new course into the subtree rooted at node.
+// Walks down iteratively and returns the new leaf, or nullptr if the course number is already present.
+// The leaf starts with no prerequisites, the caller adds them right after with addPrerequisite.
+TreeNode* BinarySearchTree::insertCourse(TreeNode* node, std::string_view courseNumber, std::string_view title) {
+    CourseId number = strings.intern(FoldedKey(courseNumber).view()); // numbers are stored uppercase, from here on the key is an integer
+    std::uint64_t key = strings.keyOf(number);
+    TreeNode* parent = nullptr;
+    bool goLeft = false;
+    while (node != nullptr) { // descend until we fall off the tree
+        parent = node;
+        if (number == node->course.number) {
+            return nullptr; // duplicate keys are ignored
+        }
+        // if the course number is less than the current node's, go to the left, otherwise go right
+        goLeft = isBefore(number, key, node->course);
+        node = goLeft ? node->left : node->right;
+    }
+
+    TreeNode* leaf = createNode(number, key, title); // create a new red treenode with the course in the arena
+    if (radixOn) {
+        radix.insert(strings.nameOf(number), leaf);
+    }
+    leaf->parent = parent;
+    if (parent == nullptr) {
+        root = leaf; // the tree was empty
+    }
+    else if (goLeft) {
+        parent->left = leaf;
+    }
+    else {
+        parent->right = leaf;
+    }
+    return leaf; // return the new node so the caller can rebalance from it
+}
+
+// Create an unlinked node for a new course. This is the one place its title is copied, straight into the pool.
+TreeNode* BinarySearchTree::createNode(CourseId number, std::uint64_t key, std::string_view title) {
+    CourseRecord record;
+    record.key = key;
+    record.number = number;
+    record.title = strings.append(title);
+    record.prereqFirst = static_cast<std::uint32_t>(prereqIds.size());
+    record.prereqCount = 0;
+    return nodes.create(record);
+}
+
+// Append a prerequisite to the course inserted last, its list has to stay at the end of prereqIds.
+void BinarySearchTree::addPrerequisite(CourseRecord& course, std::string_view prerequisite) {
+    prereqIds.push_back(strings.intern(FoldedKey(prerequisite).view()));
+    ++course.prereqCount;
+}
+
+// Rotate node down to the left, its right child takes its place.
+void BinarySearchTree::rotateLeft(TreeNode* node) {
+    TreeNode* pivot = node->right;
+    node->right = pivot->left; // pivot's left subtree moves under node
+    if (pivot->left != nullptr) {
+        pivot->left->parent = node;
+    }
+    pivot->parent = node->parent; // pivot takes node's place under its parent
+    if (node->parent == nullptr) {
+        root = pivot;
+    }
+    else if (node == node->parent->left) {
+        node->parent->left = pivot;
+    }
+    else {
+        node->parent->right = pivot;
+    }
+    pivot->left = node; // node becomes pivot's left child
+    node->parent = pivot;
+}
+
+// Rotate node down to the right, its left child takes its place.
+void BinarySearchTree::rotateRight(TreeNode* node) {
+    TreeNode* pivot = node->left;
+    node->left = pivot->right; // pivot's right subtree moves under node
+    if (pivot->right != nullptr) {
+        pivot->right->parent = node;
+    }
+    pivot->parent = node->parent; // pivot takes node's place under its parent
+    if (node->parent == nullptr) {
+        root = pivot;
+    }
+    else if (node == node->parent->right) {
+        node->parent->right = pivot;
+    }
+    else {
+        node->parent->left = pivot;
+    }
+    pivot->right = node; // node becomes pivot's right child
+    node->parent = pivot;
+}
+
+// Restore the red-black rules after inserting a red leaf.
+// source: Cormen et al., Introduction to Algorithms, RB-INSERT-FIXUP
+void BinarySearchTree::fixAfterInsert(TreeNode* node) {
+    while (node->parent != nullptr && node->parent->color == NodeColor::Red) { // a red node may not have a red parent
+        TreeNode* parent = node->parent;
+        TreeNode* grandparent = parent->parent; // exists, because a red parent is never the root
+        if (parent == grandparent->left) {
+            TreeNode* uncle = grandparent->right;
+            if (uncle != nullptr && uncle->color == NodeColor::Red) { // red uncle, recolor and move the problem up
+                parent->color = NodeColor::Black;
+                uncle->color = NodeColor::Black;
+                grandparent->color = NodeColor::Red;
+                node = grandparent;
+            }
+            else {
+                if (node == parent->right) { // inner child, rotate it to the outside first
+                    node = parent;
+                    rotateLeft(node);
+                    parent = node->parent;
+                }
+                parent->color = NodeColor::Black; // outer child, one rotation fixes it
+                grandparent->color = NodeColor::Red;
+                rotateRight(grandparent);
+            }
+        }
+        else { // mirror image of the case above
+            TreeNode* uncle = grandparent->left;
+            if (uncle != nullptr && uncle->color == NodeColor::Red) {
+                parent->color = NodeColor::Black;
+                uncle->color = NodeColor::Black;
+                grandparent->color = NodeColor::Red;
+                node = grandparent;
+            }
+            else {
+                if (node == parent->left) {
+                    node = parent;
+                    rotateRight(node);
+                    parent = node->parent;
+                }
+                parent->color = NodeColor::Black;
+                grandparent->color = NodeColor::Red;
+                rotateLeft(grandparent);
+            }
+        }
+    }
+    root->color = NodeColor::Black; // the root is always black
+}
+
+// Put replacement, which may be null, where node hangs under its parent.
+void BinarySearchTree::transplant(TreeNode* node, TreeNode* replacement) {
+    if (node->parent == nullptr) {
+        root = replacement;
+    }
+    else if (node == node->parent->left) {
+        node->parent->left = replacement;
+    }
+    else {
+        node->parent->right = replacement;
+    }
+    if (replacement != nullptr) {
+        replacement->parent = node->parent;
+    }
+}
+
+// Restore the red-black rules after removing a black node. node carries an extra black and
+// may be null, so its parent is passed separately.
+// source: Cormen et al., Introduction to Algorithms, RB-DELETE-FIXUP
+void BinarySearchTree::fixAfterErase(TreeNode* node, TreeNode* parent) {
+    auto isBlack = [](TreeNode* n) { return n == nullptr || n->color == NodeColor::Black; };
+    while (node != root && isBlack(node)) {
+        if (node == parent->left) {
+            TreeNode* sibling = parent->right; // exists, the other side is at least one black deeper
+            if (sibling->color == NodeColor::Red) { // red sibling, rotate so the sibling is black
+                sibling->color = NodeColor::Black;
+                parent->color = NodeColor::Red;
+                rotateLeft(parent);
+                sibling = parent->right;
+            }
+            if (isBlack(sibling->left) && isBlack(sibling->right)) { // take one black off both sides and move up
+                sibling->color = NodeColor::Red;
+                node = parent;
+                parent = node->parent;
+            }
+            else {
+                if (isBlack(sibling->right)) { // near nephew red, turn it into the far one
+                    sibling->left->color = NodeColor::Black;
+                    sibling->color = NodeColor::Red;
+                    rotateRight(sibling);
+                    sibling = parent->right;
+                }
+                sibling->color = parent->color; // far nephew red, one rotation fixes it
+                parent->color = NodeColor::Black;
+                sibling->right->color = NodeColor::Black;
+                rotateLeft(parent);
+                node = root;
+            }
+        }
+        else { // mirror image of the case above
+            TreeNode* sibling = parent->left;
+            if (sibling->color == NodeColor::Red) {
+                sibling->color = NodeColor::Black;
+                parent->color = NodeColor::Red;
+                rotateRight(parent);
+                sibling = parent->left;
+            }
+            if (isBlack(sibling->left) && isBlack(sibling->right)) {
+                sibling->color = NodeColor::Red;
+                node = parent;
+                parent = node->parent;
+            }
+            else {
+                if (isBlack(sibling->left)) {
+                    sibling->right->color = NodeColor::Black;
+                    sibling->color = NodeColor::Red;
+                    rotateLeft(sibling);
+                    sibling = parent->left;
+                }
+                sibling->color = parent->color;
+                parent->color = NodeColor::Black;
+                sibling->left->color = NodeColor::Black;
+                rotateRight(parent);
+                node = root;
+            }
+        }
+    }
+    if (node != nullptr) {
+        node->color = NodeColor::Black;
+    }
+}
+
+// Print course details, written as one block instead of a flush per line.
+void BinarySearchTree::printCourseDetails(const CourseCursor& course) const {
+    std::cout.flush(); // anything already printed goes first
+    ExportBuffer out(stdout, 4096);
+    WriteCourseDetails(out, course);
+}
+
+// Smallest node in the subtree rooted at node.
+TreeNode* BinarySearchTree::leftmost(TreeNode* node) {
+    if (node == nullptr) return nullptr;
+    while (node->left != nullptr) node = node->left;
+    return node;
+}
+
+// In-order successor of a node, or nullptr after the largest one.
+TreeNode* BinarySearchTree::successor(TreeNode* node) {
+    if (node->right != nullptr) { // the successor is the smallest course in the right subtree
+        return leftmost(node->right);
+    }
+    TreeNode* child = node; // otherwise climb until we arrive from a left child
+    node = node->parent;
+    while (node != nullptr && child == node->right) {
+        child = node;
+        node = node->parent;
+    }
+    return node;
+}
+
+// Find a course by course number.
+// The caller folds the number to uppercase, so nothing here allocates.
+TreeNode* BinarySearchTree::findCourse(TreeNode* node, std::string_view courseNumber) const {
+    CourseId courseNum = strings.find(courseNumber); // look up the id of the uppercase course number
+    if (courseNum == StringPool::NO_ID) {
+        return nullptr; // a number that was never interned can't be in the tree
+    }
+    std::uint64_t key = strings.keyOf(courseNum);
+
+    while (node != nullptr && node->course.number != courseNum) { // stop when the node is null or the node's course number matches the search term
+        if (isBefore(courseNum, key, node->course)) { // if the search term is less than the node's course number, search in the left subtree
+            node = node->left;
+        }
+        else { // if the search term is greater than the node's course number, search in the right subtree
+            node = node->right;
+        }
+    }
+    return node;
+}
+
+// Check if a course number sorts before a stored course. The packed prefixes decide
+// almost every compare, the pool strings are only read when they tie.
+bool BinarySearchTree::isBefore(CourseId number, std::uint64_t key, const CourseRecord& course) const {
+    if (key != course.key) return key < course.key;
+    return strings.less(number, course.number);
+}
+
+// Release every node at once. The arena frees whole slabs, so there is no tree walk.
+void BinarySearchTree::clear() {
+    frozen.clear();
+    radix.clear();
+    nodes.clear();
+    strings.clear();
+    prereqIds.clear();
+    root = nullptr;
+}
+
+// Re-lay the nodes in pre-order into a fresh arena, so each parent sits next to
+// its left child and subtrees occupy contiguous runs of memory. Records are plain ids, so copies are cheap.
+void BinarySearchTree::compact() {
+    if (root == nullptr) return;
+
+    // a node still to copy, plus where its copy has to be attached
+    struct Pending {
+        TreeNode* node;
+        TreeNode* newParent;
+        bool isLeft;
+    };
+
+    SlabArena<TreeNode> fresh(nodes.itemsPerSlab());
+    TreeNode* newRoot = nullptr;
+    std::vector<Pending> pending; // at most one entry per level plus one, the tree is balanced
+    pending.push_back({ root, nullptr, false });
+    while (!pending.empty()) {
+        Pending next = pending.back();
+        pending.pop_back();
+
+        TreeNode* copy = fresh.create(next.node->course);
+        copy->color = next.node->color;
+        copy->parent = next.newParent;
+        if (next.newParent == nullptr) {
+            newRoot = copy;
+        }
+        else if (next.isLeft) {
+            next.newParent->left = copy;
+        }
+        else {
+            next.newParent->right = copy;
+        }
+
+        // push right first so the left subtree is laid out directly after its parent
+        if (next.node->right != nullptr) pending.push_back({ next.node->right, copy, false });
+        if (next.node->left != nullptr) pending.push_back({ next.node->left, copy, true });
+    }
+
+    nodes.swap(fresh); // the old slabs are released when fresh goes out of scope
+    root = newRoot;
+    if (radixOn) {
+        rebuildRadix(); // every node moved
+    }
+}
+
+// Compile the tree into the flat Eytzinger snapshot. Lookups and listings use it
+// until the next insert or clear.
+void BinarySearchTree::freeze() {
+    thaw(); // a snapshot loaded on its own has no nodes to collect yet
+    std::vector<const CourseRecord*> sorted;
+    sorted.reserve(nodes.size());
+    forEachCourse([&sorted](const CourseRecord& course) { sorted.push_back(&course); }); // collect courses in order
+    frozen.build(sorted, *this);
+}
+
+// Insert a course, or give the course already stored under its number the new title and prerequisites.
+// A replaced title and prerequisite list stay behind in the pool until the next full load.
+// Returns true when the course was new.
+bool BinarySearchTree::upsert(std::string_view courseNumber, std::string_view title, const std::vector<std::string_view>& prerequisites) {
+    thaw(); // bring back the nodes of a snapshot loaded on its own
+    frozen.clear(); // the snapshot no longer matches the tree
+    TreeNode* node = insertCourse(root, courseNumber, title);
+    bool inserted = node != nullptr;
+    if (!inserted) { // already present, point the record at fresh copies of its fields
+        node = findCourse(root, FoldedKey(courseNumber).view());
+        node->course.title = strings.append(title);
+        node->course.prereqFirst = static_cast<std::uint32_t>(prereqIds.size());
+        node->course.prereqCount = 0;
+    }
+    for (std::string_view prereq : prerequisites) {
+        addPrerequisite(node->course, prereq);
+    }
+    if (inserted) {
+        fixAfterInsert(node); // rebalance so the depth stays logarithmic
+    }
+    return inserted;
+}
+
+// Remove a course. Its number stays interned, other courses may still list it as a prerequisite.
+// Returns false when the course isn't in the tree.
+bool BinarySearchTree::erase(std::string_view courseNumber) {
+    thaw();
+    TreeNode* node = findCourse(root, FoldedKey(courseNumber).view());
+    if (node == nullptr) return false;
+    frozen.clear();
+
+    // unlink the node, or its successor when it has two children, and remember where a black went missing
+    NodeColor removedColor = node->color;
+    TreeNode* child;
+    TreeNode* childParent;
+    if (node->left == nullptr || node->right == nullptr) {
+        child = node->left != nullptr ? node->left : node->right;
+        childParent = node->parent;
+        transplant(node, child);
+    }
+    else {
+        TreeNode* next = leftmost(node->right); // the successor takes the node's place and color
+        removedColor = next->color;
+        child = next->right;
+        if (next->parent == node) {
+            childParent = next;
+        }
+        else {
+            childParent = next->parent;
+            transplant(next, next->right);
+            next->right = node->right;
+            next->right->parent = next;
+        }
+        transplant(node, next);
+        next->left = node->left;
+        next->left->parent = next;
+        next->color = node->color;
+    }
+    if (radixOn) {
+        radix.erase(numberOf(node->course));
+    }
+    nodes.release(node); // the next new course reuses the slot
+    if (removedColor == NodeColor::Black) {
+        fixAfterErase(child, childParent);
+    }
+    return true;
+}
+
+// Build the whole tree in one pass from rows already sorted by uppercase course number, without duplicates.
+// Only works on an empty tree, returns false otherwise.
+bool BinarySearchTree::buildSorted(const std::vector<CourseFields>& sorted) {
+    thaw();
+    if (root != nullptr) return false;
+    linkSorted(sorted);
+    frozen.clear(); // the snapshot no longer matches the tree
+    return true;
+}
+
+// Rebuild the nodes from a snapshot loaded on its own, so the tree can change again.
+// The catalog stays frozen, it still matches the tree. Does nothing when the nodes exist.
+void BinarySearchTree::thaw() {
+    if (root != nullptr || frozen.isEmpty()) return;
+
+    std::vector<CourseFields> sorted;
+    std::vector<std::string_view> prerequisites; // every row's prerequisites, back to back
+    sorted.reserve(frozen.size());
+    frozen.forEachInOrder([&](std::size_t slot) {
+        sorted.push_back({ frozen.numberOf(slot), frozen.titleOf(slot), nullptr, frozen.prerequisiteCount(slot) });
+        for (std::size_t i = 0; i < frozen.prerequisiteCount(slot); ++i) {
+            prerequisites.push_back(frozen.prerequisiteOf(slot, i));
+        }
+    });
+    std::size_t next = 0; // point the rows into the finished vector, it won't move again
+    for (CourseFields& row : sorted) {
+        row.prerequisites = prerequisites.data() + next;
+        next += row.prerequisiteCount;
+    }
+    linkSorted(sorted);
+}
+
+// Create and link the nodes for sorted rows on an empty tree.
+// Each range's middle row becomes its root, so the result is balanced without rotations: every level is
+// black except the last one, which is red when it isn't full. Nodes are created in pre-order, the same
+// layout compact() produces.
+void BinarySearchTree::linkSorted(const std::vector<CourseFields>& sorted) {
+    // levels that are completely filled, a node below them sits on the partial last level
+    std::size_t n = sorted.size();
+    std::size_t fullLevels = 0;
+    while ((std::size_t(2) << fullLevels) - 1 <= n) ++fullLevels;
+
+    // a range of rows still to place, plus where its root has to be attached
+    struct Pending {
+        std::size_t first;
+        std::size_t last; // one past the end
+        std::size_t depth;
+        TreeNode* parent;
+        bool isLeft;
+    };
+
+    std::vector<Pending> pending; // at most one entry per level plus one
+    if (n > 0) pending.push_back({ 0, n, 0, nullptr, false });
+    while (!pending.empty()) {
+        Pending next = pending.back();
+        pending.pop_back();
+
+        std::size_t middle = next.first + (next.last - next.first) / 2;
+        const CourseFields& row = sorted[middle];
+        CourseId number = strings.intern(FoldedKey(row.courseNumber).view());
+        TreeNode* node = createNode(number, strings.keyOf(number), row.title);
+        if (radixOn) {
+            radix.insert(strings.nameOf(number), node);
+        }
+        for (std::size_t i = 0; i < row.prerequisiteCount; ++i) {
+            addPrerequisite(node->course, row.prerequisites[i]);
+        }
+        node->color = next.depth < fullLevels ? NodeColor::Black : NodeColor::Red;
+        node->parent = next.parent;
+        if (next.parent == nullptr) {
+            root = node;
+        }
+        else if (next.isLeft) {
+            next.parent->left = node;
+        }
+        else {
+            next.parent->right = node;
+        }
+
+        // push right first so the left subtree is laid out directly after its parent
+        if (middle + 1 < next.last) pending.push_back({ middle + 1, next.last, next.depth + 1, node, false });
+        if (next.first < middle) pending.push_back({ next.first, middle, next.depth + 1, node, true });
+    }
+}
+
+// Check if lookups are currently served by the frozen snapshot.
+bool BinarySearchTree::isFrozen() const {
+    return !frozen.isEmpty();
+}
+
+// Constructor.
+BinarySearchTree::BinarySearchTree() : root(nullptr), radixOn(false) {}
+
+// Constructor with the number of nodes each arena slab holds, 1 allocates every node on its own.
+BinarySearchTree::BinarySearchTree(std::size_t nodesPerSlab) : root(nullptr), nodes(nodesPerSlab), radixOn(false) {}
+
+// Check if the tree is empty.
+bool BinarySearchTree::isEmpty() const {
+    return root == nullptr && frozen.isEmpty(); // no nodes, and no snapshot standing in for them
+}
+
+// Number of courses, from the snapshot when the nodes aren't built.
+std::size_t BinarySearchTree::courseCount() const {
+    return root == nullptr ? frozen.size() : nodes.size();
+}
+
+// Check if the courses were loaded from a snapshot file and the nodes haven't been built yet.
+bool BinarySearchTree::isSnapshotOnly() const {
+    return root == nullptr && !frozen.isEmpty();
+}
+
+// Write the frozen catalog to a snapshot file, recording the csv it was loaded from. Only a frozen tree can be saved.
+bool BinarySearchTree::saveSnapshot(const std::string& filename, const SnapshotSource& source) const {
+    return isFrozen() && frozen.save(filename, source);
+}
+
+// Replace the tree with a snapshot file built from source. Lookups and listings read the mapped file
+// directly, the nodes are only built on the first change.
+bool BinarySearchTree::loadSnapshot(const std::string& filename, const SnapshotSource& source) {
+    clear();
+    return frozen.load(filename, source);
+}
+
+// Insert a new course into the BST.
+// The tree keeps its own copy of the text in the pool, so the course is only read, never copied.
+void BinarySearchTree::insert(const Course& newCourse) {
+    thaw(); // bring back the nodes of a snapshot loaded on its own
+    frozen.clear(); // the snapshot no longer matches the tree
+    TreeNode* leaf = insertCourse(root, newCourse.courseNumber, newCourse.title); // call the insertCourse helper function, starting at the root, to insert the new course
+    if (leaf != nullptr) {
+        for (const std::string& prereq : newCourse.prerequisites) {
+            addPrerequisite(leaf->course, prereq);
+        }
+        fixAfterInsert(leaf); // rebalance so the depth stays logarithmic
+    }
+}
+
+// Insert a course straight from its fields, without building a Course first.
+// Loaders that split lines in place pass views into their buffer, and the bytes are copied once, into the pool.
+void BinarySearchTree::emplace(std::string_view courseNumber, std::string_view title, const std::vector<std::string_view>& prerequisites) {
+    thaw(); // bring back the nodes of a snapshot loaded on its own
+    frozen.clear(); // the snapshot no longer matches the tree
+    TreeNode* leaf = insertCourse(root, courseNumber, title);
+    if (leaf != nullptr) {
+        for (std::string_view prereq : prerequisites) {
+            addPrerequisite(leaf->course, prereq);
+        }
+        fixAfterInsert(leaf); // rebalance so the depth stays logarithmic
+    }
+}
+
+// Print details of a single course.
+void BinarySearchTree::printCourse(const std::string& courseNumber) const {
+    CourseIterator course = find(courseNumber);
+    if (course != end()) { // if the course was found, print its details
+        printCourseDetails(*course);
+    }
+    else { // if the course was not found, print a message indicating so
+        std::cout << "Course not found." << std::endl;
+    }
+}
+
+// Find a single course, from the radix index when it is on, otherwise from the flat snapshot when there is one.
+CourseIterator BinarySearchTree::find(std::string_view courseNumber) const {
+    FoldedKey key(courseNumber); // fold to uppercase once, into a stack buffer
+    if (radixOn && root != nullptr) { // a snapshot loaded on its own has no nodes to index yet
+        return CourseIterator(CourseCursor(this, radix.find(key.view()), 0));
+    }
+    if (isFrozen()) {
+        return CourseIterator(CourseCursor(this, nullptr, frozen.find(key.view())));
+    }
+    return CourseIterator(CourseCursor(this, findCourse(root, key.view()), 0));
+}
+
+
+
+// Print all courses in the BST.
+void BinarySearchTree::printAllCourses() const {
+    if (isEmpty()) { // check if the bst is empty before trying to print
+        std::cout << "The tree is empty." << std::endl;
+        return;
+    }
+    std::cout.flush(); // anything already printed goes first
+    ExportBuffer out(stdout); // the listing goes out a block at a time, not a flush per course
+    out.put('\n');
+    ExportCourses(*this, ExportFormat::Listing, out);
+    out.put('\n');
+}
+
+// Turn the radix index on or off. Turning it on indexes the nodes there are now, turning it off frees it.
+void BinarySearchTree::useRadixIndex(bool enabled) {
+    radixOn = enabled;
+    radix.clear();
+    if (enabled) {
+        rebuildRadix();
+    }
+}
+
+// Index every node from scratch, in sorted order.
+void BinarySearchTree::rebuildRadix() {
+    radix.clear();
+    for (TreeNode* node = leftmost(root); node != nullptr; node = successor(node)) {
+        radix.insert(numberOf(node->course), node);
+    }
+}
+
+// First course in sorted order.
+CourseIterator BinarySearchTree::begin() const {
+    if (isFrozen()) {
+        return CourseIterator(CourseCursor(this, nullptr, frozen.firstSlot()));
+    }
+    return CourseIterator(CourseCursor(this, leftmost(root), 0));
+}
+
+// Node of the first course whose (uppercase) number is not before courseNumber, or with after set,
+// the first one after it. The number may never have been interned, so the descent compares the
+// packed prefix and then the text instead of ids.
+TreeNode* BinarySearchTree::boundNode(std::string_view courseNumber, bool after) const {
+    std::uint64_t key = StringPool::packKey(courseNumber);
+    TreeNode* bound = nullptr;
+    TreeNode* node = root;
+    while (node != nullptr) {
+        const CourseRecord& course = node->course;
+        bool before = course.key < key // the node's number comes before the bound, so the bound is to the right
+            || (course.key == key && (after ? numberOf(course) <= courseNumber : numberOf(course) < courseNumber));
+        if (before) {
+            node = node->right;
+        }
+        else { // a candidate, look for an earlier one on the left
+            bound = node;
+            node = node->left;
+        }
+    }
+    return bound;
+}
+
+// Iterator at the lower or upper bound of a course number, from whichever copy serves lookups.
+CourseIterator BinarySearchTree::bound(std::string_view courseNumber, bool after) const {
+    FoldedKey key(courseNumber);
+    if (isFrozen()) {
+        return CourseIterator(CourseCursor(this, nullptr, frozen.bound(key.view(), after)));
+    }
+    return CourseIterator(CourseCursor(this, boundNode(key.view(), after), 0));
+}
+
+CourseIterator BinarySearchTree::lowerBound(std::string_view courseNumber) const {
+    return bound(courseNumber, false);
+}
+
+CourseIterator BinarySearchTree::upperBound(std::string_view courseNumber) const {
+    return bound(courseNumber, true);
+}
+
+// Courses from first up to, but not including, last. O(log n) to find both ends.
+CourseRange BinarySearchTree::range(std::string_view first, std::string_view last) const {
+    CourseRange courses = { lowerBound(first), lowerBound(last) };
+    if (FoldedKey(last).view() < FoldedKey(first).view()) {
+        courses.last = courses.first; // an inverted range is empty
+    }
+    return courses;
+}
+
+// Every course whose number starts with prefix. The range ends at the first number past all
+// of them, the prefix with its last byte bumped by one, e.g. "CSCI3" ends before "CSCI4".
+CourseRange BinarySearchTree::withPrefix(std::string_view prefix) const {
+    FoldedKey folded(prefix);
+    std::string limit(folded.view());
+    while (!limit.empty() && static_cast<unsigned char>(limit.back()) == 0xFF) {
+        limit.pop_back(); // nothing follows a run of 0xFF bytes at this length
+    }
+    CourseRange courses = { bound(folded.view(), false), end() };
+    if (!limit.empty()) {
+        limit.back() = static_cast<char>(static_cast<unsigned char>(limit.back()) + 1);
+        courses.last = bound(limit, false);
+    }
+    return courses;
+}
+
+// Step to the next course in sorted order.
+CourseIterator& CourseIterator::operator++() {
+    if (cursor.node != nullptr) {
+        cursor.node = BinarySearchTree::successor(cursor.node);
+    }
+    else {
+        cursor.slot = cursor.bst->frozen.nextSlot(cursor.slot);
+    }
+    return *this;
+}
+
+std::string_view CourseCursor::number() const {
+    return node != nullptr ? bst->numberOf(node->course) : bst->frozen.numberOf(slot);
+}
+
+std::string_view CourseCursor::title() const {
+    return node != nullptr ? bst->titleOf(node->course) : bst->frozen.titleOf(slot);
+}
+
+std::size_t CourseCursor::prerequisiteCount() const {
+    return node != nullptr ? node->course.prereqCount : bst->frozen.prerequisiteCount(slot);
+}
+
+std::string_view CourseCursor::prerequisite(std::size_t i) const {
+    return node != nullptr ? bst->strings.nameOf(bst->prerequisiteOf(node->course, i)) : bst->frozen.prerequisiteOf(slot, i);
+}
+
+// Destructor.
+BinarySearchTree::~BinarySearchTree() {
+    // the nodes arena releases its slabs on its own
+}
@@ -1,66 +1,256 @@
-//==========================================================================================
-// Name        : BinarySearchTree.h
-// Author      : John St Hilaire
-// Version     : 1.0
-// Last Updated : 2/25/23
-// Description : Header file for Binary Search Tree class for Project 1 for CS300 at SNHU
-//==========================================================================================
-
-#pragma once
-#ifndef BINARYSEARCHTREE_H
-#define BINARYSEARCHTREE_H
-
-#include <string>
-#include <vector>
-#include <iostream>
-#include <algorithm> // For std::transform
-#include <cctype>    // For std::toupper
-
-
-// course structure to hold course data
-struct Course {
-    std::string courseNumber;
-    std::string title;
-    std::vector<std::string> prerequisites;
-
-    // constructor for the Course structure
-    Course(std::string num, std::string tit, std::vector<std::string> prereqs)
-        : courseNumber(num), title(tit), prerequisites(prereqs) {}
-};
-
-// TreeNode structure for the Binary Search Tree
-struct TreeNode {
-    Course course;
-    TreeNode* left;
-    TreeNode* right;
-
-    // constructor for the TreeNode structure
-    TreeNode(Course c) : course(c), left(nullptr), right(nullptr) {}
-};
-
-// BinarySearchTree class
-class BinarySearchTree {
-private:
-    TreeNode* root;
-
-    // helper methods
-    TreeNode* insertCourse(TreeNode* node, Course newCourse);
-    void printCourseDetails(TreeNode* node) const;
-    void inOrderTraversal(TreeNode* node) const;
-    void deleteAllNodes(TreeNode* node);
-    std::string toUpperCase(const std::string& str) const;
-
-    TreeNode* findCourse(TreeNode* node, const std::string& courseNumber) const;
-
-public:
-    BinarySearchTree(); // constructor
-    ~BinarySearchTree(); // destructor
-    void insert(Course newCourse);
-    bool isEmpty() const;
-    void printCourse(const std::string& courseNumber) const;
-    void printAllCourses() const;
-
-    // additional methods can be declared here
-};
-
-#endif // BINARYSEARCHTREE_H
+//==========================================================================================
+// Name        : BinarySearchTree.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 2/25/23
+// Description : Header file for Binary Search Tree class for Project 1 for CS300 at SNHU
+//==========================================================================================
+
+#pragma once
+#ifndef BINARYSEARCHTREE_H
+#define BINARYSEARCHTREE_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <string_view>
+#include <utility>   // For std::move
+#include <iterator>  // For std::forward_iterator_tag
+#include <cstddef>   // For std::ptrdiff_t
+#include "CaseFold.h"
+#include "SlabArena.h"
+#include "FrozenCatalog.h"
+#include "StringPool.h"
+#include "RadixIndex.h"
+
+
+// course structure to hold course data as it comes out of the file
+struct Course {
+    std::string courseNumber;
+    std::string title;
+    std::vector<std::string> prerequisites;
+
+    // constructor for the Course structure, the arguments are moved in rather than copied
+    Course(std::string num, std::string tit, std::vector<std::string> prereqs)
+        : courseNumber(std::move(num)), title(std::move(tit)), prerequisites(std::move(prereqs)) {}
+
+#ifdef COURSE_COUNT_COPIES
+    // build with COURSE_COUNT_COPIES defined to count every deep copy of a Course
+    static inline std::size_t copies = 0;
+    Course(const Course& other)
+        : courseNumber(other.courseNumber), title(other.title), prerequisites(other.prerequisites) { ++copies; }
+    Course(Course&&) = default;
+    Course& operator=(const Course& other) {
+        courseNumber = other.courseNumber;
+        title = other.title;
+        prerequisites = other.prerequisites;
+        ++copies;
+        return *this;
+    }
+    Course& operator=(Course&&) = default;
+#endif
+};
+
+// a course as the tree stores it: interned ids and pool references instead of strings
+struct CourseRecord {
+    std::uint64_t key;         // packed 8-byte prefix of the number, so the descent compares inside the node
+    CourseId number;           // interned course number
+    PoolString title;          // title text in the tree's string pool
+    std::uint32_t prereqFirst; // first entry in the tree's prerequisite id list
+    std::uint32_t prereqCount; // number of prerequisites
+};
+
+// one parsed row, its fields are views into the loader's buffer
+struct CourseFields {
+    std::string_view courseNumber;
+    std::string_view title;
+    const std::string_view* prerequisites; // prerequisiteCount views, owned by the loader
+    std::size_t prerequisiteCount;
+};
+
+// node colors for the red-black balancing rules
+enum class NodeColor : unsigned char { Red, Black };
+
+// TreeNode structure for the Binary Search Tree
+struct TreeNode {
+    CourseRecord course;
+    TreeNode* left;
+    TreeNode* right;
+    TreeNode* parent; // lets insert fix-up and traversals walk back up without recursion
+    NodeColor color;
+
+    // constructor for the TreeNode structure, new nodes start red
+    TreeNode(CourseRecord c) : course(c), left(nullptr), right(nullptr), parent(nullptr), color(NodeColor::Red) {}
+};
+
+class BinarySearchTree;
+
+// CourseCursor is one position in the catalog's sorted order. It reads the tree's nodes,
+// or the frozen catalog's slots while the tree is frozen, so callers see the same course either way.
+class CourseCursor {
+private:
+    friend class BinarySearchTree;
+    friend class CourseIterator;
+
+    const BinarySearchTree* bst;
+    TreeNode* node;       // position in the tree, when it isn't frozen
+    std::size_t slot;     // position in the frozen catalog, 0 otherwise
+
+    CourseCursor(const BinarySearchTree* tree, TreeNode* treeNode, std::size_t frozenSlot)
+        : bst(tree), node(treeNode), slot(frozenSlot) {}
+
+public:
+    CourseCursor() : bst(nullptr), node(nullptr), slot(0) {}
+
+    std::string_view number() const;
+    std::string_view title() const;
+    std::size_t prerequisiteCount() const;
+    std::string_view prerequisite(std::size_t i) const;
+};
+
+// CourseIterator walks courses in sorted order, one step at a time, with no recursion and no
+// list built up front. A step is O(1) amortized. Any change to the tree invalidates it, a
+// walk can be resumed afterwards with upperBound() on the last number it saw.
+class CourseIterator {
+private:
+    friend class BinarySearchTree;
+
+    CourseCursor cursor;
+
+    explicit CourseIterator(CourseCursor position) : cursor(position) {}
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = CourseCursor;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const CourseCursor*;
+    using reference = const CourseCursor&;
+
+    CourseIterator() {}
+
+    reference operator*() const { return cursor; }
+    pointer operator->() const { return &cursor; }
+    CourseIterator& operator++();
+    CourseIterator operator++(int) {
+        CourseIterator before = *this;
+        ++*this;
+        return before;
+    }
+
+    bool operator==(const CourseIterator& other) const { return cursor.node == other.cursor.node && cursor.slot == other.cursor.slot; }
+    bool operator!=(const CourseIterator& other) const { return !(*this == other); }
+};
+
+// a run of courses in sorted order, for range-based for loops
+struct CourseRange {
+    CourseIterator first;
+    CourseIterator last; // one past the end
+
+    CourseIterator begin() const { return first; }
+    CourseIterator end() const { return last; }
+    bool empty() const { return first == last; }
+};
+
+// BinarySearchTree class
+// The tree is kept balanced with the red-black rules so sorted registrar exports
+// can't degrade it into a linked list. Every algorithm is iterative, so depth is
+// bounded by 2*log2(n+1) and nothing recurses on large catalogs.
+class BinarySearchTree {
+private:
+    friend class CourseCursor;
+    friend class CourseIterator;
+
+    TreeNode* root;
+    SlabArena<TreeNode> nodes; // every TreeNode lives in this arena
+    StringPool strings;        // course numbers and titles for every node
+    std::vector<CourseId> prereqIds; // prerequisite lists of every node, back to back
+    FrozenCatalog frozen;      // flat read-only copy, used for lookups while it is current
+    RadixIndex radix;          // course numbers to nodes, kept in step with the nodes while radixOn
+    bool radixOn;
+
+    // helper methods
+    TreeNode* insertCourse(TreeNode* node, std::string_view courseNumber, std::string_view title);
+    TreeNode* createNode(CourseId number, std::uint64_t key, std::string_view title);
+    void addPrerequisite(CourseRecord& course, std::string_view prerequisite);
+    void rotateLeft(TreeNode* node);
+    void rotateRight(TreeNode* node);
+    void fixAfterInsert(TreeNode* node);
+    void fixAfterErase(TreeNode* node, TreeNode* parent);
+    void transplant(TreeNode* node, TreeNode* replacement);
+    void printCourseDetails(const CourseCursor& course) const;
+    TreeNode* boundNode(std::string_view courseNumber, bool after) const;
+    CourseIterator bound(std::string_view courseNumber, bool after) const;
+    static TreeNode* leftmost(TreeNode* node);
+    static TreeNode* successor(TreeNode* node);
+    bool isBefore(CourseId number, std::uint64_t key, const CourseRecord& course) const;
+    void linkSorted(const std::vector<CourseFields>& sorted);
+    void rebuildRadix();
+
+    TreeNode* findCourse(TreeNode* node, std::string_view courseNumber) const;
+
+public:
+    BinarySearchTree(); // constructor
+    explicit BinarySearchTree(std::size_t nodesPerSlab); // for comparing slab sizes, see SlabArena
+    ~BinarySearchTree(); // destructor
+    void insert(const Course& newCourse);
+    void emplace(std::string_view courseNumber, std::string_view title, const std::vector<std::string_view>& prerequisites);
+    bool upsert(std::string_view courseNumber, std::string_view title, const std::vector<std::string_view>& prerequisites);
+    bool erase(std::string_view courseNumber);
+    bool buildSorted(const std::vector<CourseFields>& sorted);
+    void thaw();
+    void clear();
+    void compact();
+    void freeze();
+    bool isFrozen() const;
+    bool isEmpty() const;
+    std::size_t courseCount() const;
+    bool saveSnapshot(const std::string& filename, const SnapshotSource& source) const;
+    bool loadSnapshot(const std::string& filename, const SnapshotSource& source);
+    bool isSnapshotOnly() const;
+    void printCourse(const std::string& courseNumber) const;
+    void printAllCourses() const;
+
+    // answer find() and printAllCourses() from an adaptive radix tree over the course numbers,
+    // built now and kept up to date by every change until it is turned off
+    void useRadixIndex(bool enabled);
+    bool hasRadixIndex() const { return radixOn; }
+    const RadixIndex& radixIndex() const { return radix; }
+
+    // courses in sorted order, numbers are matched without regard to case
+    CourseIterator begin() const;
+    CourseIterator end() const { return CourseIterator(); }
+    CourseIterator find(std::string_view courseNumber) const; // the course, or end() when there is none
+    CourseIterator lowerBound(std::string_view courseNumber) const; // first course not before courseNumber
+    CourseIterator upperBound(std::string_view courseNumber) const; // first course after courseNumber
+    CourseRange range(std::string_view first, std::string_view last) const; // from first up to, not including, last
+    CourseRange withPrefix(std::string_view prefix) const; // every course whose number starts with prefix
+
+    // visit every course in sorted order without recursion
+    template <typename Visitor>
+    void forEachCourse(Visitor visit) const {
+        for (TreeNode* node = leftmost(root); node != nullptr; node = successor(node)) {
+            visit(static_cast<const CourseRecord&>(node->course));
+        }
+    }
+
+    // visit every course in sorted order as a cursor, through the radix index when it is on
+    template <typename Visitor>
+    void forEachCursor(Visitor visit) const {
+        if (radixOn && root != nullptr) {
+            radix.forEachInOrder([&](TreeNode* node) { visit(CourseCursor(this, node, 0)); });
+        }
+        else {
+            for (const CourseCursor& course : *this) visit(course);
+        }
+    }
+
+    // access to the strings behind a stored course
+    const StringPool& pool() const { return strings; }
+    std::string_view numberOf(const CourseRecord& course) const { return strings.nameOf(course.number); }
+    std::string_view titleOf(const CourseRecord& course) const { return strings.view(course.title); }
+    CourseId prerequisiteOf(const CourseRecord& course, std::size_t i) const { return prereqIds[course.prereqFirst + i]; }
+
+    // additional methods can be declared here
+};
+
+#endif // BINARYSEARCHTREE_H
@@ -0,0 +1,46 @@
+//=========================================================================
+// Name        : CaseFold.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : ASCII uppercase folding into caller buffers for course lookups
+//=========================================================================
+
+#include "CaseFold.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CASEFOLD_SSE2
+#include <emmintrin.h> // For the SSE2 intrinsics
+#endif
+
+// Uppercase the ASCII letters of src into dst.
+void foldUpper(const char* src, std::size_t length, char* dst) {
+    std::size_t i = 0;
+#ifdef CASEFOLD_SSE2
+    // a byte is lowercase when 'a'-1 < c < 'z'+1, the signed compares also leave bytes >= 0x80 alone
+    const __m128i aboveA = _mm_set1_epi8('a' - 1);
+    const __m128i belowZ = _mm_set1_epi8('z' + 1);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chunk, aboveA), _mm_cmplt_epi8(chunk, belowZ));
+        chunk = _mm_sub_epi8(chunk, _mm_and_si128(lower, caseBit)); // clear the case bit on lowercase letters only
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), chunk);
+    }
+#endif
+    for (; i < length; ++i) { // the tail, or everything without SSE2
+        char c = src[i];
+        dst[i] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 0x20) : c;
+    }
+}
+
+// Fold the key once, into the stack buffer when it fits.
+FoldedKey::FoldedKey(std::string_view key) : length(key.size()) {
+    if (length <= CAPACITY) {
+        foldUpper(key.data(), length, buffer);
+    }
+    else {
+        overflow.resize(length);
+        foldUpper(key.data(), length, &overflow[0]);
+    }
+}
@@ -0,0 +1,39 @@
+//=========================================================================
+// Name        : CaseFold.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : ASCII uppercase folding into caller buffers for course lookups
+//=========================================================================
+
+#pragma once
+#ifndef CASEFOLD_H
+#define CASEFOLD_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Uppercase the ASCII letters of src into dst, which must hold length bytes.
+// Works 16 bytes at a time with SSE2 where the compiler offers it.
+void foldUpper(const char* src, std::size_t length, char* dst);
+
+// FoldedKey is a lookup key folded to uppercase once, into a buffer on the stack.
+// Course numbers always fit, only keys longer than CAPACITY spill to the heap.
+class FoldedKey {
+private:
+    static constexpr std::size_t CAPACITY = 64;
+
+    char buffer[CAPACITY];
+    std::string overflow; // only used for keys that don't fit in buffer
+    std::size_t length;
+
+public:
+    explicit FoldedKey(std::string_view key);
+
+    std::string_view view() const {
+        return std::string_view(length <= CAPACITY ? buffer : overflow.data(), length);
+    }
+};
+
+#endif // CASEFOLD_H
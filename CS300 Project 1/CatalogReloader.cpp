@@ -0,0 +1,170 @@
+//=========================================================================
+// Name        : CatalogReloader.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Applies only the changed rows of a reloaded courses file
+//=========================================================================
+
+#include "CatalogReloader.h"
+
+// FNV-1a over the bytes of a field, continuing from hash. Course numbers are hashed
+// folded to uppercase, the way the tree stores them, so "csci100" matches a stored "CSCI100".
+// source: http://www.isthe.com/chongo/tech/comp/fnv/
+static std::uint64_t hashBytes(std::uint64_t hash, std::string_view field, bool foldCase) {
+    for (char c : field) {
+        if (foldCase && c >= 'a' && c <= 'z') c = static_cast<char>(c - 0x20);
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    hash ^= 0x1F; // field separator, so moving bytes between fields changes the hash
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+// Constructor.
+CatalogReloader::CatalogReloader() : rowCount(0), usedSlots(0), pass(0), primed(false), counts() {}
+
+// Hash a row with its numbers folded and the title as written. Never returns EMPTY_ROW or REMOVED_ROW.
+std::uint64_t CatalogReloader::hashRow(std::string_view courseNumber, std::string_view title,
+    const std::string_view* prerequisites, std::size_t prerequisiteCount) {
+    std::uint64_t hash = hashBytes(14695981039346656037ull, courseNumber, true);
+    hash = hashBytes(hash, title, false);
+    for (std::size_t i = 0; i < prerequisiteCount; ++i) {
+        hash = hashBytes(hash, prerequisites[i], true);
+    }
+    return hash <= REMOVED_ROW ? hash + 2 : hash;
+}
+
+// Find the slot holding a row hash, or the empty slot that ends its probe.
+std::size_t CatalogReloader::slotFor(std::uint64_t hash) const {
+    std::size_t mask = table.size() - 1;
+    std::size_t slot = static_cast<std::size_t>(hash ^ (hash >> 32)) & mask;
+    while (table[slot].hash != hash && table[slot].hash != EMPTY_ROW) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Store a row that isn't in the table yet, for this pass.
+void CatalogReloader::addRow(std::uint64_t hash, CourseId id) {
+    if ((usedSlots + 1) * 4 > table.size() * 3) { // keep the table at most 3/4 full, removed slots included
+        grow();
+    }
+    std::size_t mask = table.size() - 1;
+    std::size_t slot = static_cast<std::size_t>(hash ^ (hash >> 32)) & mask;
+    while (table[slot].hash > REMOVED_ROW) { // the first free slot will do, removed ones included
+        slot = (slot + 1) & mask;
+    }
+    if (table[slot].hash == EMPTY_ROW) {
+        ++usedSlots;
+    }
+    table[slot] = { hash, id, pass };
+    ++rowCount;
+}
+
+// Drop a stored row, leaving a marker so later probes still get past its slot.
+void CatalogReloader::removeRow(std::uint64_t hash) {
+    std::size_t slot = slotFor(hash);
+    if (table[slot].hash == hash) {
+        table[slot].hash = REMOVED_ROW;
+        --rowCount;
+    }
+}
+
+// Rebuild the table with room for twice the rows, clearing out the removed markers.
+void CatalogReloader::grow() {
+    std::size_t capacity = 64;
+    while (capacity < (rowCount + 1) * 2) capacity *= 2;
+    std::vector<RowEntry> old(capacity, RowEntry{ EMPTY_ROW, 0, 0 });
+    old.swap(table);
+    std::size_t mask = table.size() - 1;
+    for (const RowEntry& entry : old) {
+        if (entry.hash <= REMOVED_ROW) continue;
+        std::size_t slot = static_cast<std::size_t>(entry.hash ^ (entry.hash >> 32)) & mask;
+        while (table[slot].hash != EMPTY_ROW) slot = (slot + 1) & mask;
+        table[slot] = entry;
+    }
+    usedSlots = rowCount;
+}
+
+// Forget every hash.
+void CatalogReloader::reset() {
+    table.clear();
+    rowHashes.clear();
+    rowCount = 0;
+    usedSlots = 0;
+    primed = false;
+}
+
+// Start a pass. The first pass after a full load hashes what the tree holds, once.
+void CatalogReloader::begin(BinarySearchTree& bst) {
+    counts = ReloadChanges();
+    if (!primed) {
+        bst.thaw(); // a snapshot start has no nodes to hash yet
+        reset();
+        rowHashes.assign(bst.pool().size(), EMPTY_ROW);
+        std::vector<std::string_view> prerequisites; // reused between courses to keep its capacity
+        bst.forEachCourse([&](const CourseRecord& course) {
+            prerequisites.clear();
+            for (std::size_t i = 0; i < course.prereqCount; ++i) {
+                prerequisites.push_back(bst.pool().nameOf(bst.prerequisiteOf(course, i)));
+            }
+            std::uint64_t hash = hashRow(bst.numberOf(course), bst.titleOf(course), prerequisites.data(), prerequisites.size());
+            rowHashes[course.number] = hash;
+            addRow(hash, course.number);
+        });
+        primed = true;
+    }
+    ++pass; // every stored row now belongs to an older pass
+}
+
+// Compare one row of the new file with the stored ones and change the tree only if it is new.
+// A course number that appears twice keeps its first row, like the loaders.
+void CatalogReloader::apply(BinarySearchTree& bst, std::string_view courseNumber, std::string_view title, const std::vector<std::string_view>& prerequisites) {
+    std::uint64_t hash = hashRow(courseNumber, title, prerequisites.data(), prerequisites.size());
+    if (!table.empty()) {
+        RowEntry& entry = table[slotFor(hash)];
+        if (entry.hash == hash) { // the row is stored already, or it repeats one seen in this pass
+            if (entry.pass != pass) {
+                entry.pass = pass;
+                ++counts.unchanged;
+            }
+            return;
+        }
+    }
+
+    // a new or changed row, only now is the course looked up
+    FoldedKey number(courseNumber);
+    CourseId id = bst.pool().find(number.view());
+    if (id != StringPool::NO_ID && id < rowHashes.size() && rowHashes[id] != EMPTY_ROW) {
+        if (table[slotFor(rowHashes[id])].pass == pass) return; // an earlier row in this file already gave this course
+        removeRow(rowHashes[id]); // the old row is replaced below
+    }
+    if (bst.upsert(courseNumber, title, prerequisites)) {
+        ++counts.inserted;
+    }
+    else {
+        ++counts.updated;
+    }
+    id = bst.pool().find(number.view()); // interned now
+    if (id >= rowHashes.size()) {
+        rowHashes.resize(id + 1, EMPTY_ROW);
+    }
+    rowHashes[id] = hash;
+    addRow(hash, id);
+}
+
+// Remove the courses whose row wasn't in this pass. Replaced rows are gone from the table
+// already, so every row left behind is the current one of a course that was dropped.
+void CatalogReloader::finish(BinarySearchTree& bst) {
+    for (RowEntry& entry : table) {
+        if (entry.hash > REMOVED_ROW && entry.pass != pass) {
+            bst.erase(bst.pool().nameOf(entry.id));
+            rowHashes[entry.id] = EMPTY_ROW;
+            entry.hash = REMOVED_ROW;
+            --rowCount;
+            ++counts.deleted;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//=========================================================================
+// Name        : CatalogReloader.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Applies only the changed rows of a reloaded courses file
+//=========================================================================
+
+#pragma once
+#ifndef CATALOGRELOADER_H
+#define CATALOGRELOADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "BinarySearchTree.h"
+
+// what one reload changed
+struct ReloadChanges {
+    std::size_t inserted;
+    std::size_t updated;
+    std::size_t deleted;
+    std::size_t unchanged;
+
+    std::size_t total() const { return inserted + updated + deleted; }
+};
+
+// CatalogReloader keeps a hash of every loaded row in a table keyed by that hash.
+// A reload hashes each row of the new file: a row already in the table is unchanged
+// and costs one probe, only the other rows look their course up and touch the tree,
+// plus the courses no row mentioned any more. A pass goes begin(), apply() for every
+// row, then finish().
+class CatalogReloader {
+private:
+    // one stored row
+    struct RowEntry {
+        std::uint64_t hash; // EMPTY_ROW or REMOVED_ROW when the slot holds no row
+        CourseId id;        // course the row was stored for
+        std::uint32_t pass; // last pass that had this row
+    };
+
+    static constexpr std::uint64_t EMPTY_ROW = 0;
+    static constexpr std::uint64_t REMOVED_ROW = 1;
+
+    std::vector<RowEntry> table;          // open addressing on the row hash, linear probing
+    std::size_t rowCount;                 // slots holding a row
+    std::size_t usedSlots;                // slots holding a row or REMOVED_ROW
+    std::vector<std::uint64_t> rowHashes; // course id -> hash of its stored row, EMPTY_ROW when the id isn't a course
+    std::uint32_t pass;
+    bool primed; // the table matches the tree
+    ReloadChanges counts;
+
+    std::size_t slotFor(std::uint64_t hash) const;
+    void addRow(std::uint64_t hash, CourseId id);
+    void removeRow(std::uint64_t hash);
+    void grow();
+
+public:
+    CatalogReloader();
+
+    static std::uint64_t hashRow(std::string_view courseNumber, std::string_view title,
+        const std::string_view* prerequisites, std::size_t prerequisiteCount);
+
+    void reset(); // forget the hashes, the next pass takes them from the tree again
+    void begin(BinarySearchTree& bst);
+    void apply(BinarySearchTree& bst, std::string_view courseNumber, std::string_view title, const std::vector<std::string_view>& prerequisites);
+    void finish(BinarySearchTree& bst);
+
+    const ReloadChanges& changes() const { return counts; }
+};
+
+#endif // CATALOGRELOADER_H
@@ -0,0 +1,126 @@
+//=========================================================================
+// Name        : CourseClient.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Sends course queries to a CourseServer over its Unix socket
+//=========================================================================
+
+#include "CourseClient.h"
+
+#ifdef __linux__
+#include <cerrno>       // For errno
+#include <cstring>      // For std::memcpy
+#include <sys/socket.h> // For socket and connect
+#include <sys/un.h>     // For sockaddr_un
+#include <unistd.h>     // For read and close
+#endif
+
+// Constructor.
+CourseClient::CourseClient() : fd(-1), inPos(0) {}
+
+// Destructor.
+CourseClient::~CourseClient() {
+    close();
+}
+
+#ifdef __linux__
+
+// Connect to the server listening on path.
+bool CourseClient::connect(const std::string& path) {
+    close();
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Close the connection.
+void CourseClient::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    in.clear();
+    inPos = 0;
+}
+
+// Send request lines, all of them are written before returning.
+bool CourseClient::send(std::string_view requests) {
+    while (!requests.empty()) {
+        ssize_t bytes = ::send(fd, requests.data(), requests.size(), MSG_NOSIGNAL);
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        requests.remove_prefix(static_cast<std::size_t>(bytes));
+    }
+    return true;
+}
+
+// Read one line of an answer, reading more from the socket when the buffer holds no full line.
+bool CourseClient::readLine(std::string& line) {
+    std::size_t searchFrom = inPos;
+    while (true) {
+        std::size_t end = in.find('\n', searchFrom);
+        if (end != std::string::npos) {
+            line.assign(in, inPos, end - inPos);
+            inPos = end + 1;
+            return true;
+        }
+        if (inPos > 0) { // drop what was returned already before the buffer grows
+            in.erase(0, inPos);
+            inPos = 0;
+        }
+        searchFrom = in.size();
+        char buffer[64 * 1024];
+        ssize_t bytes = ::read(fd, buffer, sizeof(buffer));
+        if (bytes < 0 && errno == EINTR) continue;
+        if (bytes <= 0) return false;
+        in.append(buffer, static_cast<std::size_t>(bytes));
+    }
+}
+
+#else
+
+bool CourseClient::connect(const std::string&) {
+    return false; // the server only runs on Linux
+}
+
+void CourseClient::close() {}
+
+bool CourseClient::send(std::string_view) {
+    return false;
+}
+
+bool CourseClient::readLine(std::string&) {
+    return false;
+}
+
+#endif
+
+// Read the next answer: "OK <n>" and its n course lines.
+bool CourseClient::readAnswer(std::size_t& count, std::vector<std::string>* lines) {
+    count = 0;
+    std::string line;
+    if (!readLine(line) || line.compare(0, 3, "OK ") != 0) {
+        return false;
+    }
+    count = static_cast<std::size_t>(std::stoull(line.substr(3)));
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!readLine(line)) return false;
+        if (lines != nullptr) lines->push_back(line);
+    }
+    return true;
+}
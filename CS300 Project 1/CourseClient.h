@@ -0,0 +1,44 @@
+//=========================================================================
+// Name        : CourseClient.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Sends course queries to a CourseServer over its Unix socket
+//=========================================================================
+
+#pragma once
+#ifndef COURSECLIENT_H
+#define COURSECLIENT_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// CourseClient talks to a CourseServer. Requests can be sent several at a time and their
+// answers read back one by one, in the order they were sent.
+class CourseClient {
+private:
+    int fd; // -1 when not connected
+    std::string in;    // bytes read but not yet returned
+    std::size_t inPos; // start of the unread part of in
+
+    bool readLine(std::string& line);
+
+public:
+    CourseClient(); // constructor
+    ~CourseClient(); // destructor, closes the connection
+
+    CourseClient(const CourseClient&) = delete;
+    CourseClient& operator=(const CourseClient&) = delete;
+
+    bool connect(const std::string& path);
+    void close();
+    bool send(std::string_view requests); // one or more request lines, each ending in a newline
+
+    // read the next answer, lines gets its course lines when given
+    // returns false if the connection failed or the server answered ERR
+    bool readAnswer(std::size_t& count, std::vector<std::string>* lines = nullptr);
+};
+
+#endif // COURSECLIENT_H
@@ -0,0 +1,356 @@
+//=========================================================================
+// Name        : CourseExporter.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Streams the catalog out as CSV, JSON Lines or binary through one large buffer
+//=========================================================================
+
+#include "CourseExporter.h"
+#include "CaseFold.h"
+
+#ifdef _WIN32
+#include <fcntl.h> // For _O_BINARY
+#include <io.h>    // For _setmode and _fileno
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EXPORT_SSE2
+#include <emmintrin.h> // For the SSE2 intrinsics
+#endif
+
+// first bytes of a binary export, then the format version and the course count as varints
+static const char EXPORT_MAGIC[8] = { 'C', 'S', '3', '0', '0', 'E', 'X', 'P' };
+static const std::uint64_t EXPORT_VERSION = 1;
+
+// Constructor.
+ExportBuffer::ExportBuffer(std::FILE* destination, std::size_t bufferBytes)
+    : out(destination), buffer(new char[bufferBytes]), capacity(bufferBytes), used(0), handedOver(0), failed(false) {}
+
+// Destructor.
+ExportBuffer::~ExportBuffer() {
+    flush();
+}
+
+// Hand the buffered bytes to the stream in one write.
+void ExportBuffer::drain() {
+    if (used > 0 && !failed && std::fwrite(buffer.get(), 1, used, out) != used) {
+        failed = true;
+    }
+    handedOver += used;
+    used = 0;
+}
+
+// Bytes that don't fit in the rest of the block: fill it, and write anything still bigger than a block straight through.
+void ExportBuffer::appendLong(std::string_view bytes) {
+    std::size_t room = capacity - used;
+    std::char_traits<char>::copy(buffer.get() + used, bytes.data(), room);
+    used = capacity;
+    bytes.remove_prefix(room);
+    drain();
+    if (bytes.size() >= capacity) {
+        if (!failed && std::fwrite(bytes.data(), 1, bytes.size(), out) != bytes.size()) {
+            failed = true;
+        }
+        handedOver += bytes.size();
+        return;
+    }
+    append(bytes);
+}
+
+// Append a number 7 bits at a time, the high bit of a byte set when more follow.
+void ExportBuffer::appendVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+        put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    put(static_cast<char>(value));
+}
+
+// Write out the block and flush the stream behind it.
+bool ExportBuffer::flush() {
+    drain();
+    if (!failed && std::fflush(out) != 0) {
+        failed = true;
+    }
+    return !failed;
+}
+
+// bytes that make a CSV field need quotes
+static const struct CsvSpecial {
+    bool byte[256];
+    CsvSpecial() : byte() {
+        byte[static_cast<unsigned char>(',')] = true;
+        byte[static_cast<unsigned char>('"')] = true;
+        byte[static_cast<unsigned char>('\r')] = true;
+        byte[static_cast<unsigned char>('\n')] = true;
+    }
+} CSV_SPECIAL;
+
+// Check a field for a comma, quote or line break, 16 bytes at a time with SSE2 where the compiler offers it.
+static bool needsQuotes(std::string_view field) {
+    std::size_t i = 0;
+#ifdef EXPORT_SSE2
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    for (; i + 16 <= field.size(); i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(field.data() + i));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, quote)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+        if (_mm_movemask_epi8(hits) != 0) return true;
+    }
+#endif
+    bool special = false;
+    for (; i < field.size(); ++i) { // the tail, or everything without SSE2
+        special |= CSV_SPECIAL.byte[static_cast<unsigned char>(field[i])];
+    }
+    return special;
+}
+
+// Append a CSV field, quoted only when it holds a comma, quote or line break.
+static void appendCsvField(ExportBuffer& out, std::string_view field) {
+    if (!needsQuotes(field)) {
+        out.append(field); // every field the loaders produce, they split on commas
+        return;
+    }
+    out.put('"');
+    std::size_t start = 0;
+    std::size_t quote;
+    while ((quote = field.find('"', start)) != std::string_view::npos) { // a quote is written twice
+        out.append(field.substr(start, quote + 1 - start));
+        out.put('"');
+        start = quote + 1;
+    }
+    out.append(field.substr(start));
+    out.put('"');
+}
+
+// bytes a JSON string has to escape: quotes, backslashes and control characters
+static const struct JsonEscaped {
+    bool byte[256];
+    JsonEscaped() : byte() {
+        for (int c = 0; c < 0x20; ++c) byte[c] = true;
+        byte[static_cast<unsigned char>('"')] = true;
+        byte[static_cast<unsigned char>('\\')] = true;
+    }
+} JSON_ESCAPED;
+
+// Position of the first byte from i on that a JSON string has to escape, the text's size when there is none.
+static std::size_t nextEscape(std::string_view text, std::size_t i) {
+#ifdef EXPORT_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= text.size(); i += 16) { // skip whole blocks with nothing to escape
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control)); // a byte at most 0x1F is a control character
+        if (_mm_movemask_epi8(hits) != 0) break; // the byte loop finds which one
+    }
+#endif
+    for (; i < text.size(); ++i) {
+        if (JSON_ESCAPED.byte[static_cast<unsigned char>(text[i])]) return i;
+    }
+    return text.size();
+}
+
+// Append a JSON string, escaping quotes, backslashes and control characters. Other bytes pass through as they are.
+static void appendJsonString(ExportBuffer& out, std::string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+    out.put('"');
+    std::size_t start = 0;
+    std::size_t i;
+    while ((i = nextEscape(text, start)) < text.size()) {
+        out.append(text.substr(start, i - start)); // the plain run before this byte in one copy
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        out.put('\\');
+        switch (c) {
+        case '"': out.put('"'); break;
+        case '\\': out.put('\\'); break;
+        case '\n': out.put('n'); break;
+        case '\r': out.put('r'); break;
+        case '\t': out.put('t'); break;
+        default:
+            out.append("u00");
+            out.put(HEX[c >> 4]);
+            out.put(HEX[c & 0xF]);
+            break;
+        }
+        start = i + 1;
+    }
+    out.append(text.substr(start));
+    out.put('"');
+}
+
+// Write a course as a CSV row.
+void WriteCsvRow(ExportBuffer& out, const CourseCursor& course) {
+    appendCsvField(out, course.number());
+    out.put(',');
+    appendCsvField(out, course.title());
+    for (std::size_t i = 0; i < course.prerequisiteCount(); ++i) {
+        out.put(',');
+        appendCsvField(out, course.prerequisite(i));
+    }
+    out.put('\n');
+}
+
+// Write a course as one JSON object on its own line.
+void WriteJsonLine(ExportBuffer& out, const CourseCursor& course) {
+    out.append("{\"number\":");
+    appendJsonString(out, course.number());
+    out.append(",\"title\":");
+    appendJsonString(out, course.title());
+    out.append(",\"prerequisites\":[");
+    for (std::size_t i = 0; i < course.prerequisiteCount(); ++i) {
+        if (i > 0) out.put(',');
+        appendJsonString(out, course.prerequisite(i));
+    }
+    out.append("]}\n");
+}
+
+// Write a course as length-prefixed fields: number, title, prerequisite count, then each prerequisite.
+void WriteBinaryRecord(ExportBuffer& out, const CourseCursor& course) {
+    out.appendVarint(course.number().size());
+    out.append(course.number());
+    out.appendVarint(course.title().size());
+    out.append(course.title());
+    out.appendVarint(course.prerequisiteCount());
+    for (std::size_t i = 0; i < course.prerequisiteCount(); ++i) {
+        std::string_view prerequisite = course.prerequisite(i);
+        out.appendVarint(prerequisite.size());
+        out.append(prerequisite);
+    }
+}
+
+// Append the course list format.
+static void appendListingLine(ExportBuffer& out, std::string_view number, std::string_view title) {
+    out.append(number);
+    out.append(", ");
+    out.append(title);
+    out.put('\n');
+}
+
+// Write a course the way the course list shows it.
+void WriteListingLine(ExportBuffer& out, const CourseCursor& course) {
+    appendListingLine(out, course.number(), course.title());
+}
+
+// Write a compiled catalog's course the way the course list shows it.
+void WriteListingLine(ExportBuffer& out, const StaticCourse& course) {
+    appendListingLine(out, course.number, course.title);
+}
+
+// Append the single course lookup format. appendPrerequisite(i) writes the i-th prerequisite number, so every
+// representation of a course shares one copy of the layout.
+template <typename AppendPrerequisite>
+static void appendCourseDetails(ExportBuffer& out, std::string_view number, std::string_view title,
+    std::size_t prerequisiteCount, AppendPrerequisite appendPrerequisite) {
+    out.append("\nCourse Number: ");
+    out.append(number);
+    out.append("\nTitle: ");
+    out.append(title);
+    out.append("\nPrerequisites: ");
+    if (prerequisiteCount == 0) { // if there are no prerequisites, print 'None'
+        out.append("None\n");
+    }
+    else {
+        for (std::size_t i = 0; i < prerequisiteCount; ++i) {
+            appendPrerequisite(i);
+            out.put(' ');
+        }
+    }
+    out.put('\n');
+}
+
+// Write a course the way a single course lookup shows it.
+void WriteCourseDetails(ExportBuffer& out, const CourseCursor& course) {
+    appendCourseDetails(out, course.number(), course.title(), course.prerequisiteCount(),
+        [&](std::size_t i) { out.append(course.prerequisite(i)); });
+}
+
+// Write a parsed row the way a single course lookup shows it. The row's prerequisites are still as the file
+// spells them, so they are folded the way the tree stores them.
+void WriteCourseDetails(ExportBuffer& out, const CourseFields& course) {
+    appendCourseDetails(out, course.courseNumber, course.title, course.prerequisiteCount,
+        [&](std::size_t i) { out.append(FoldedKey(course.prerequisites[i]).view()); });
+}
+
+// Write a compiled catalog's course the way a single course lookup shows it.
+void WriteCourseDetails(ExportBuffer& out, const StaticCatalog& catalog, const StaticCourse& course) {
+    appendCourseDetails(out, course.number, course.title, course.prereqCount,
+        [&](std::size_t i) { out.append(catalog.prerequisite(course, i).number); });
+}
+
+// Write every course in sorted order. The writer is picked once, not per course.
+std::size_t ExportCourses(const BinarySearchTree& bst, ExportFormat format, ExportBuffer& out) {
+    void (*write)(ExportBuffer&, const CourseCursor&) = WriteListingLine;
+    switch (format) {
+    case ExportFormat::Csv: write = WriteCsvRow; break;
+    case ExportFormat::JsonLines: write = WriteJsonLine; break;
+    case ExportFormat::Binary:
+        write = WriteBinaryRecord;
+        out.append(std::string_view(EXPORT_MAGIC, sizeof(EXPORT_MAGIC)));
+        out.appendVarint(EXPORT_VERSION);
+        out.appendVarint(bst.courseCount());
+        break;
+    case ExportFormat::Listing: break;
+    }
+    std::size_t courses = 0;
+    bst.forEachCursor([&](const CourseCursor& course) {
+        write(out, course);
+        ++courses;
+    });
+    return courses;
+}
+
+// Export the catalog to path, "-" for standard output. Returns false if the file can't be
+// opened or a write fails, e.g. the disk filled up or the reader of a pipe went away.
+bool ExportCatalog(const BinarySearchTree& bst, ExportFormat format, const std::string& path, std::size_t& courses, std::size_t& bytes) {
+    bool toStdout = path == "-";
+    std::FILE* file = toStdout ? stdout : std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+#ifdef _WIN32
+    int textMode = -1;
+    if (toStdout) { // text mode would turn every \n into \r\n and corrupt a binary export
+        std::fflush(stdout);
+        textMode = _setmode(_fileno(stdout), _O_BINARY);
+    }
+#endif
+    bool success;
+    {
+        ExportBuffer out(file);
+        courses = ExportCourses(bst, format, out);
+        success = out.flush();
+        bytes = out.bytesWritten();
+    }
+#ifdef _WIN32
+    if (textMode != -1) {
+        _setmode(_fileno(stdout), textMode); // the menu keeps printing text afterwards
+    }
+#endif
+    if (!toStdout && std::fclose(file) != 0) {
+        success = false;
+    }
+    return success;
+}
+
+// Map a format name to its format. Returns false for a name it doesn't know.
+bool ParseExportFormat(std::string_view name, ExportFormat& format) {
+    if (name == "csv") {
+        format = ExportFormat::Csv;
+    }
+    else if (name == "jsonl" || name == "json") {
+        format = ExportFormat::JsonLines;
+    }
+    else if (name == "bin" || name == "binary") {
+        format = ExportFormat::Binary;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+//=========================================================================
+// Name        : CourseExporter.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Streams the catalog out as CSV, JSON Lines or binary through one large buffer
+//=========================================================================
+
+#pragma once
+#ifndef COURSEEXPORTER_H
+#define COURSEEXPORTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "BinarySearchTree.h"
+#include "StaticCatalog.h"
+
+// what an export writes for each course
+enum class ExportFormat {
+    Csv,       // number,title,prerequisites... the same layout the loaders read
+    JsonLines, // one {"number":...,"title":...,"prerequisites":[...]} object per line
+    Binary,    // a header, then lengths as LEB128 varints followed by the bytes
+    Listing    // "number, title", what printAllCourses shows
+};
+
+// ExportBuffer collects output in one block and hands it to the stream a block at a time,
+// so writing a course costs a memcpy instead of a flush and a system call per line.
+// Nothing reaches the stream before flush() or the block filling up.
+class ExportBuffer {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+private:
+    std::FILE* out;
+    std::unique_ptr<char[]> buffer;
+    std::size_t capacity;
+    std::size_t used;
+    std::size_t handedOver; // bytes already written to out
+    bool failed;
+
+    void drain();
+
+public:
+    explicit ExportBuffer(std::FILE* destination, std::size_t bufferBytes = DEFAULT_CAPACITY);
+    ~ExportBuffer(); // flushes whatever is left
+
+    ExportBuffer(const ExportBuffer&) = delete;
+    ExportBuffer& operator=(const ExportBuffer&) = delete;
+
+    void append(std::string_view bytes) {
+        if (bytes.size() > capacity - used) {
+            appendLong(bytes);
+            return;
+        }
+        std::char_traits<char>::copy(buffer.get() + used, bytes.data(), bytes.size());
+        used += bytes.size();
+    }
+    void put(char c) {
+        if (used == capacity) drain();
+        buffer[used++] = c;
+    }
+    void appendLong(std::string_view bytes); // for bytes that don't fit in what is left of the block
+    void appendVarint(std::uint64_t value);  // LEB128, 7 bits a byte, low bits first
+
+    bool flush(); // write out everything buffered and flush the stream, false once any write failed
+    bool ok() const { return !failed; }
+    std::size_t bytesWritten() const { return handedOver + used; }
+};
+
+// one course in each format
+void WriteCsvRow(ExportBuffer& out, const CourseCursor& course);
+void WriteJsonLine(ExportBuffer& out, const CourseCursor& course);
+void WriteBinaryRecord(ExportBuffer& out, const CourseCursor& course);
+void WriteListingLine(ExportBuffer& out, const CourseCursor& course);
+void WriteCourseDetails(ExportBuffer& out, const CourseCursor& course);
+void WriteCourseDetails(ExportBuffer& out, const CourseFields& course); // a row still in the loader's slices
+
+// one course of a compiled catalog, in the same listing and lookup formats
+void WriteListingLine(ExportBuffer& out, const StaticCourse& course);
+void WriteCourseDetails(ExportBuffer& out, const StaticCatalog& catalog, const StaticCourse& course);
+
+// every course in sorted order, returns how many were written
+std::size_t ExportCourses(const BinarySearchTree& bst, ExportFormat format, ExportBuffer& out);
+
+// export to a file, or to standard output when path is "-" so the catalog can be piped on
+bool ExportCatalog(const BinarySearchTree& bst, ExportFormat format, const std::string& path, std::size_t& courses, std::size_t& bytes);
+bool ParseExportFormat(std::string_view name, ExportFormat& format); // "csv", "jsonl" or "bin"
+
+#endif // COURSEEXPORTER_H
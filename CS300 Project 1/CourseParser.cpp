@@ -0,0 +1,161 @@
+//=========================================================================
+// Name        : CourseParser.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Splits courses file rows in place and merges parsed chunks
+//=========================================================================
+
+#include "CourseParser.h"
+#include "CaseFold.h"
+
+#include <algorithm>  // For std::stable_sort, std::merge and std::unique
+#include <atomic>     // For handing out merges to the threads
+#include <thread>     // For merging runs in parallel
+
+// Cut the next comma separated field off the front of a line, without copying.
+static std::string_view NextField(std::string_view& line) {
+    std::size_t comma = line.find(',');
+    std::string_view field = line.substr(0, comma);
+    line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    return field;
+}
+
+// Cut the next line off the front of the text, without copying.
+std::string_view NextLine(std::string_view& text) {
+    std::size_t newline = text.find('\n');
+    std::string_view line = text.substr(0, newline);
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1); // tolerate files saved with windows line endings
+    }
+    return line;
+}
+
+// Split a non-empty line into its fields, appending the prerequisites.
+void SplitRow(std::string_view line, std::string_view& courseNumber, std::string_view& title,
+    std::vector<std::string_view>& prerequisites) {
+    courseNumber = NextField(line); // get the course number
+    title = NextField(line); // get the title
+    while (!line.empty()) { // get all prerequisites
+        std::string_view prerequisite = NextField(line);
+        if (!prerequisite.empty()) {
+            prerequisites.push_back(prerequisite);
+        }
+    }
+}
+
+// Cut text into about parts newline-aligned slices, so no row is split between two of them.
+std::vector<std::string_view> SliceText(std::string_view text, std::size_t parts) {
+    std::vector<std::string_view> slices;
+    std::size_t begin = 0;
+    for (std::size_t t = 1; t <= parts && begin < text.size(); ++t) {
+        std::size_t end = text.size();
+        if (t < parts) {
+            end = text.find('\n', std::max(begin, text.size() * t / parts));
+            end = (end == std::string_view::npos) ? text.size() : end + 1;
+        }
+        slices.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return slices;
+}
+
+// order parsed rows by their folded course numbers
+bool RowBefore(const CourseFields& a, const CourseFields& b) {
+    return a.courseNumber < b.courseNumber;
+}
+
+// Parse one newline-aligned slice of the file and sort its rows.
+void ParseChunk(std::string_view text, ParsedChunk& chunk) {
+    chunk.numbers.reserve(text.size()); // numbers are a subset of the text, so views into it stay valid
+    while (!text.empty()) {
+        std::string_view line = NextLine(text);
+        if (line.empty()) {
+            continue; // skip blank lines
+        }
+
+        CourseFields row;
+        std::size_t firstPrerequisite = chunk.prerequisites.size();
+        SplitRow(line, row.courseNumber, row.title, chunk.prerequisites);
+        std::size_t at = chunk.numbers.size();
+        chunk.numbers.append(row.courseNumber.data(), row.courseNumber.size());
+        foldUpper(&chunk.numbers[at], row.courseNumber.size(), &chunk.numbers[at]); // fold once so sorting is a plain compare
+        row.courseNumber = std::string_view(chunk.numbers.data() + at, row.courseNumber.size());
+        row.prerequisites = nullptr; // the vector may still grow, pointers are filled in below
+        row.prerequisiteCount = chunk.prerequisites.size() - firstPrerequisite;
+        chunk.rows.push_back(row);
+    }
+
+    std::size_t at = 0;
+    for (CourseFields& row : chunk.rows) {
+        row.prerequisites = chunk.prerequisites.data() + at;
+        at += row.prerequisiteCount;
+    }
+    std::stable_sort(chunk.rows.begin(), chunk.rows.end(), RowBefore); // stable, so the first of two duplicates stays first
+}
+
+// Run task(i) for every i below count, on at most one thread per core counting the caller.
+// The threads take the next i as they finish one, so a round of many small merges, like the
+// background loader's slices give, doesn't start a thread for each.
+template <typename Task>
+static void RunOnCores(std::size_t count, Task task) {
+    std::size_t threads = std::min<std::size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    std::atomic<std::size_t> next(0);
+    auto work = [&next, count, &task]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            task(i);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) worker.join();
+}
+
+// Merge the sorted rows of every chunk into one sorted list, the chunks in file order.
+// Later duplicates of a course number are dropped, rows counts every row before that.
+// The chunks are only read, so other threads may keep searching them meanwhile.
+std::vector<CourseFields> MergeChunks(const std::vector<ParsedChunk>& chunks, std::size_t& rows) {
+    for (const ParsedChunk& chunk : chunks) {
+        rows += chunk.rows.size();
+    }
+    if (chunks.empty()) return std::vector<CourseFields>();
+
+    // the first round merges neighbouring chunks in place into new runs, earlier chunks win ties
+    // so file order is kept for duplicates
+    std::vector<std::vector<CourseFields>> runs((chunks.size() + 1) / 2);
+    auto mergeChunks = [&chunks, &runs](std::size_t i) {
+        const std::vector<CourseFields>& first = chunks[2 * i].rows;
+        if (2 * i + 1 == chunks.size()) {
+            runs[i] = first; // odd chunk out is copied as is
+            return;
+        }
+        const std::vector<CourseFields>& second = chunks[2 * i + 1].rows;
+        runs[i].resize(first.size() + second.size());
+        std::merge(first.begin(), first.end(), second.begin(), second.end(), runs[i].begin(), RowBefore);
+    };
+    RunOnCores(runs.size(), mergeChunks);
+
+    // then the runs in rounds the same way
+    while (runs.size() > 1) {
+        std::vector<std::vector<CourseFields>> merged(runs.size() / 2 + runs.size() % 2);
+        auto mergePair = [&runs, &merged](std::size_t i) {
+            merged[i].resize(runs[2 * i].size() + runs[2 * i + 1].size());
+            std::merge(runs[2 * i].begin(), runs[2 * i].end(), runs[2 * i + 1].begin(), runs[2 * i + 1].end(),
+                merged[i].begin(), RowBefore);
+        };
+        RunOnCores(runs.size() / 2, mergePair);
+        if (runs.size() % 2 == 1) merged.back() = std::move(runs.back()); // odd run out moves up a round as is
+        runs.swap(merged);
+    }
+
+    // drop later duplicates, the serial loaders ignore them too
+    std::vector<CourseFields> sorted = std::move(runs[0]);
+    sorted.erase(std::unique(sorted.begin(), sorted.end(),
+        [](const CourseFields& a, const CourseFields& b) { return a.courseNumber == b.courseNumber; }), sorted.end());
+
+    return sorted;
+}
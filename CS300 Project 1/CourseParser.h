@@ -0,0 +1,37 @@
+//=========================================================================
+// Name        : CourseParser.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Splits courses file rows in place and merges parsed chunks
+//=========================================================================
+
+#pragma once
+#ifndef COURSEPARSER_H
+#define COURSEPARSER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BinarySearchTree.h"
+
+// rows parsed from one slice of the file
+struct ParsedChunk {
+    std::string numbers;                         // course numbers folded to uppercase, back to back
+    std::vector<std::string_view> prerequisites; // every row's prerequisites, back to back
+    std::vector<CourseFields> rows;              // sorted by course number once parsing is done
+};
+
+// splitting the mapped file without copying, every view points into the text
+std::string_view NextLine(std::string_view& text);
+void SplitRow(std::string_view line, std::string_view& courseNumber, std::string_view& title,
+    std::vector<std::string_view>& prerequisites);
+std::vector<std::string_view> SliceText(std::string_view text, std::size_t parts);
+
+// parsing slices into sorted rows and merging them back together
+bool RowBefore(const CourseFields& a, const CourseFields& b);
+void ParseChunk(std::string_view text, ParsedChunk& chunk);
+std::vector<CourseFields> MergeChunks(const std::vector<ParsedChunk>& chunks, std::size_t& rows);
+
+#endif // COURSEPARSER_H
@@ -0,0 +1,454 @@
+//=========================================================================
+// Name        : CourseServer.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Serves course queries to other processes over a Unix socket
+//=========================================================================
+
+#include "CourseServer.h"
+
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>         // For errno
+#include <cstdint>        // For std::uint64_t
+#include <cstring>        // For std::memcpy and std::strerror
+#include <sys/epoll.h>    // For the event loops
+#include <sys/eventfd.h>  // For waking every loop on stop
+#include <sys/socket.h>   // For socket, bind, listen, connect and accept4
+#include <sys/stat.h>     // For checking what is at the socket path
+#include <sys/un.h>       // For sockaddr_un
+#include <unistd.h>       // For read, write, close and unlink
+#endif
+
+// one client connection, owned by the worker whose epoll it is registered with
+struct CourseServer::Connection {
+    int fd;
+    int epollFd;          // the worker's epoll
+    std::string in;       // requests not answered yet, the last one maybe not ended by a newline yet
+    std::string out;      // answers not yet written
+    std::size_t outSent;  // bytes of out already written
+    unsigned watching;    // events registered with the epoll
+    bool readClosed;      // the client sent everything it will, its answers may still be going out
+};
+
+static const std::size_t READ_SIZE = 64 * 1024;       // bytes read from a connection at a time
+static const std::size_t MAX_REQUEST = 64 * 1024;     // longest request line accepted
+static const std::size_t MAX_PENDING = 4 * 1024 * 1024; // unwritten answer bytes before a connection stops being answered and read
+
+// Split off the next space separated word of a request.
+static std::string_view NextArgument(std::string_view& rest) {
+    std::size_t start = rest.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+        rest = std::string_view();
+        return rest;
+    }
+    rest.remove_prefix(start);
+    std::size_t end = rest.find(' ');
+    std::string_view word = rest.substr(0, end);
+    rest.remove_prefix(end == std::string_view::npos ? rest.size() : end);
+    return word;
+}
+
+// Constructor.
+CourseServer::CourseServer(const BinarySearchTree& tree, const PrerequisiteGraph& prerequisites)
+    : bst(tree), graph(prerequisites), listenFd(-1), stopFd(-1) {}
+
+// Destructor.
+CourseServer::~CourseServer() {
+    stop();
+    shutdown();
+}
+
+// Append one course as a line of the answer, the same way the csv lists it.
+void CourseServer::appendCourse(const CourseCursor& course, std::string& out) const {
+    out.append(course.number());
+    out.push_back(',');
+    out.append(course.title());
+    for (std::size_t i = 0; i < course.prerequisiteCount(); ++i) {
+        out.push_back(',');
+        out.append(course.prerequisite(i));
+    }
+    out.push_back('\n');
+}
+
+// Answer one request line. The count of course lines is only known once they are written,
+// so the header goes in front of them afterwards.
+void CourseServer::answer(std::string_view request, std::string& out) const {
+    if (!request.empty() && request.back() == '\r') {
+        request.remove_suffix(1); // tolerate clients that end lines with CRLF
+    }
+    std::string_view rest = request;
+    std::string_view command = NextArgument(rest);
+    std::string_view first = NextArgument(rest);
+    std::string_view second = NextArgument(rest);
+
+    std::size_t headerAt = out.size();
+    std::size_t count = 0;
+    if (command == "FIND" && !first.empty()) {
+        CourseIterator course = bst.find(first);
+        if (course != bst.end()) {
+            appendCourse(*course, out);
+            count = 1;
+        }
+    }
+    else if (command == "LIST") {
+        for (const CourseCursor& course : bst) {
+            appendCourse(course, out);
+            ++count;
+        }
+    }
+    else if (command == "RANGE" && !second.empty()) {
+        for (const CourseCursor& course : bst.range(first, second)) {
+            appendCourse(course, out);
+            ++count;
+        }
+    }
+    else if (command == "PREFIX" && !first.empty()) {
+        for (const CourseCursor& course : bst.withPrefix(first)) {
+            appendCourse(course, out);
+            ++count;
+        }
+    }
+    else if (command == "PREREQS" && !first.empty()) {
+        std::size_t vertex = graph.idOf(FoldedKey(first).view());
+        if (vertex != PrerequisiteGraph::NOT_FOUND) {
+            for (std::size_t prerequisite : graph.allPrerequisites(vertex)) {
+                CourseIterator course = bst.find(graph.nameOf(prerequisite));
+                if (course != bst.end()) {
+                    appendCourse(*course, out);
+                }
+                else { // listed as a prerequisite but not in the catalog, only the number is known
+                    out.append(graph.nameOf(prerequisite));
+                    out.push_back('\n');
+                }
+                ++count;
+            }
+        }
+    }
+    else {
+        out.append("ERR unknown or incomplete request: ");
+        out.append(request.substr(0, 80));
+        out.push_back('\n');
+        return;
+    }
+    out.insert(headerAt, "OK " + std::to_string(count) + "\n");
+}
+
+#ifdef __linux__
+
+// Make room for the socket at path. Nothing there, or a socket file left behind by a server that
+// is gone, is fine and the file is removed. Anything else there is left alone: a regular file, or
+// a socket a running server still accepts connections on.
+static bool ClearSocketPath(const std::string& path, const sockaddr_un& address) {
+    struct stat status;
+    if (::lstat(path.c_str(), &status) != 0) {
+        if (errno == ENOENT) return true;
+        std::cout << "Could not check " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!S_ISSOCK(status.st_mode)) {
+        std::cout << path << " exists and is not a socket, not replacing it" << std::endl;
+        return false;
+    }
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (probe < 0) {
+        std::cout << "Could not create a socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    bool refused = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 && errno == ECONNREFUSED;
+    ::close(probe);
+    if (!refused) { // connected, or a full backlog, either way a server is there
+        std::cout << "A server is already listening on " << path << std::endl;
+        return false;
+    }
+    if (::unlink(path.c_str()) != 0) {
+        std::cout << "Could not remove the stale socket " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Start listening on path with workerCount worker threads. A stale socket file left by an
+// earlier run is replaced, anything else at path makes start fail.
+bool CourseServer::start(const std::string& path, std::size_t workerCount) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cout << "Socket path is empty or too long: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    if (!ClearSocketPath(path, address)) {
+        return false;
+    }
+
+    // report a failed call and release whatever was set up before it
+    auto fail = [this](const char* what) {
+        int error = errno;
+        shutdown();
+        std::cout << what << ": " << std::strerror(error) << std::endl;
+        return false;
+    };
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        return fail("Could not create a socket");
+    }
+    if (::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        int error = errno;
+        ::close(listenFd);
+        listenFd = -1;
+        std::cout << "Could not listen on " << path << ": " << std::strerror(error) << std::endl;
+        return false;
+    }
+    socketPath = path; // the socket file is ours from here, shutdown() removes it
+    if (::listen(listenFd, SOMAXCONN) != 0) {
+        return fail("Could not listen on the socket");
+    }
+    stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stopFd < 0) {
+        return fail("Could not create the stop event");
+    }
+
+    // the stop eventfd sits in every worker's epoll with a null pointer, it stays readable once written
+    workerCount = workerCount == 0 ? 1 : workerCount;
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0) {
+            return fail("Could not create a worker's epoll");
+        }
+        workerEpolls.push_back(epollFd);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) != 0) {
+            return fail("Could not watch the stop event");
+        }
+    }
+    for (int epollFd : workerEpolls) {
+        workers.emplace_back(&CourseServer::workerLoop, this, epollFd);
+    }
+    return true;
+}
+
+// Accept connections and hand them to the workers in turn, until stop() is called.
+void CourseServer::run() {
+    if (listenFd < 0) return;
+
+    int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    bool watching = epollFd >= 0 && ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+    event.data.fd = stopFd;
+    watching = watching && ::epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) == 0;
+    if (!watching) {
+        std::cout << "Could not watch the listening socket: " << std::strerror(errno) << std::endl;
+        if (epollFd >= 0) ::close(epollFd);
+        stop();
+        shutdown();
+        return;
+    }
+
+    std::size_t nextWorker = 0;
+    bool stopping = false;
+    while (!stopping) {
+        epoll_event ready[2];
+        int count = ::epoll_wait(epollFd, ready, 2, -1);
+        if (count < 0 && errno != EINTR) break;
+        for (int i = 0; i < count; ++i) {
+            if (ready[i].data.fd == stopFd) {
+                stopping = true;
+                continue;
+            }
+            while (true) { // take every waiting connection
+                int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) break;
+                Connection* connection = new Connection{ fd, workerEpolls[nextWorker], std::string(), std::string(), 0, EPOLLIN, false };
+                nextWorker = (nextWorker + 1) % workerEpolls.size();
+                {
+                    std::lock_guard<std::mutex> lock(connectionsMutex);
+                    connections.insert(connection);
+                }
+                epoll_event clientEvent = {};
+                clientEvent.events = EPOLLIN;
+                clientEvent.data.ptr = connection;
+                if (::epoll_ctl(connection->epollFd, EPOLL_CTL_ADD, fd, &clientEvent) != 0) {
+                    closeConnection(connection); // no worker would ever see it
+                }
+                // the worker owns it from here
+            }
+        }
+    }
+    ::close(epollFd);
+    shutdown();
+}
+
+// Ask run() and every worker to return. Only writes to the eventfd, so a signal handler may call it.
+void CourseServer::stop() {
+    if (stopFd >= 0) {
+        std::uint64_t one = 1;
+        ssize_t written = ::write(stopFd, &one, sizeof(one));
+        (void)written; // a full counter still leaves the eventfd readable
+    }
+}
+
+// One worker's event loop: read requests, answer them, write the answers back.
+void CourseServer::workerLoop(int epollFd) {
+    epoll_event ready[64];
+    while (true) {
+        int count = ::epoll_wait(epollFd, ready, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            Connection* connection = static_cast<Connection*>(ready[i].data.ptr);
+            if (connection == nullptr) {
+                return; // stop() was called
+            }
+            if (!serviceConnection(*connection, ready[i].events)) {
+                closeConnection(connection);
+            }
+        }
+    }
+}
+
+// Handle the events of one connection. Returns false when it should be closed.
+bool CourseServer::serviceConnection(Connection& connection, unsigned events) {
+    if (events & EPOLLERR) {
+        return false;
+    }
+    bool backedUp = connection.out.size() - connection.outSent > MAX_PENDING;
+    if ((events & (EPOLLIN | EPOLLHUP)) && !connection.readClosed && !backedUp) {
+        char buffer[READ_SIZE];
+        ssize_t bytes = ::read(connection.fd, buffer, sizeof(buffer));
+        if (bytes == 0) {
+            connection.readClosed = true; // the client is done sending, the answers still go out
+        }
+        else if (bytes < 0) {
+            if (errno != EAGAIN && errno != EINTR) return false;
+        }
+        else {
+            connection.in.append(buffer, static_cast<std::size_t>(bytes));
+        }
+    }
+
+    // answer and write until the socket is full, or no complete request is left
+    bool requestsLeft;
+    do {
+        requestsLeft = answerRequests(connection);
+        if (!flush(connection)) return false;
+    } while (requestsLeft && connection.out.empty());
+
+    if (!requestsLeft && connection.in.size() > MAX_REQUEST) {
+        return false; // a request line that never ends
+    }
+    if (connection.readClosed && connection.out.empty()) {
+        return false; // every answer is out, a last line without a newline is dropped
+    }
+    return true;
+}
+
+// Answer the complete requests in connection.in until the unwritten answers pass MAX_PENDING, so a
+// client that pipelines many large requests can't make the server build all the answers at once.
+// The requests answered are removed from in. Returns true if complete requests are left.
+bool CourseServer::answerRequests(Connection& connection) const {
+    std::size_t start = 0;
+    std::size_t end;
+    while (connection.out.size() - connection.outSent <= MAX_PENDING
+        && (end = connection.in.find('\n', start)) != std::string::npos) {
+        answer(std::string_view(connection.in).substr(start, end - start), connection.out);
+        start = end + 1;
+    }
+    connection.in.erase(0, start);
+    return connection.in.find('\n') != std::string::npos;
+}
+
+// Write as much of the pending answers as the socket takes. While some are left the connection
+// waits for EPOLLOUT, and past MAX_PENDING it stops reading new requests until the client catches up.
+bool CourseServer::flush(Connection& connection) {
+    while (connection.outSent < connection.out.size()) {
+        ssize_t bytes = ::send(connection.fd, connection.out.data() + connection.outSent,
+            connection.out.size() - connection.outSent, MSG_NOSIGNAL);
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN) return false;
+            break;
+        }
+        connection.outSent += static_cast<std::size_t>(bytes);
+    }
+    if (connection.outSent == connection.out.size()) {
+        connection.out.clear();
+        connection.outSent = 0;
+    }
+    else if (connection.outSent >= MAX_PENDING) { // drop what was written before more answers go behind it
+        connection.out.erase(0, connection.outSent);
+        connection.outSent = 0;
+    }
+
+    std::size_t pending = connection.out.size() - connection.outSent;
+    unsigned watching = (pending > 0 ? EPOLLOUT : 0u) | (!connection.readClosed && pending <= MAX_PENDING ? EPOLLIN : 0u);
+    if (watching != connection.watching) {
+        epoll_event event = {};
+        event.events = watching;
+        event.data.ptr = &connection;
+        if (::epoll_ctl(connection.epollFd, EPOLL_CTL_MOD, connection.fd, &event) != 0) return false;
+        connection.watching = watching;
+    }
+    return true;
+}
+
+// Close and free one connection.
+void CourseServer::closeConnection(Connection* connection) {
+    ::epoll_ctl(connection->epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+    ::close(connection->fd);
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        connections.erase(connection);
+    }
+    delete connection;
+}
+
+// Join the workers and release every descriptor, the socket file is removed.
+void CourseServer::shutdown() {
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    for (Connection* connection : connections) {
+        ::close(connection->fd);
+        delete connection;
+    }
+    connections.clear();
+    for (int epollFd : workerEpolls) {
+        ::close(epollFd);
+    }
+    workerEpolls.clear();
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(socketPath.c_str());
+        listenFd = -1;
+    }
+    if (stopFd >= 0) {
+        ::close(stopFd);
+        stopFd = -1;
+    }
+}
+
+#else
+
+bool CourseServer::start(const std::string&, std::size_t) {
+    std::cout << "Serving over a Unix socket is only supported on Linux." << std::endl;
+    return false;
+}
+
+void CourseServer::run() {}
+
+void CourseServer::stop() {}
+
+void CourseServer::shutdown() {}
+
+#endif
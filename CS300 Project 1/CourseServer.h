@@ -0,0 +1,76 @@
+//=========================================================================
+// Name        : CourseServer.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Serves course queries to other processes over a Unix socket
+//=========================================================================
+
+#pragma once
+#ifndef COURSESERVER_H
+#define COURSESERVER_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "BinarySearchTree.h"
+#include "PrerequisiteGraph.h"
+
+// CourseServer lets scripts query a catalog that was loaded once, instead of starting the planner
+// and parsing the csv every time. It listens on a Unix domain socket. One thread accepts
+// connections and hands them to the workers in turn, and each worker runs its own epoll loop
+// over its connections. The catalog is only read while serving, so the workers share it
+// without locks. Requests are lines of text:
+//     FIND <number>         the course
+//     LIST                  every course
+//     RANGE <first> <last>  courses from first up to, not including, last
+//     PREFIX <prefix>       courses whose number starts with prefix
+//     PREREQS <number>      every course needed before number, directly or not
+// Each answer is a line "OK <n>" followed by n lines of number,title[,prerequisite...], or one
+// line "ERR <reason>". A client may send many requests before reading, and may shut down its
+// side once it has sent them all. Complete requests are answered until about MAX_PENDING bytes of
+// answers wait to be written, the rest once the client has read those, and the answers go back
+// together in as few writes as the socket allows.
+// Serving is only supported on Linux.
+class CourseServer {
+private:
+    struct Connection;
+
+    const BinarySearchTree& bst;
+    const PrerequisiteGraph& graph;
+    std::string socketPath;
+    int listenFd; // -1 when not started
+    int stopFd;   // eventfd, readable once stop() was called
+    std::vector<int> workerEpolls; // one epoll descriptor per worker
+    std::vector<std::thread> workers;
+    std::mutex connectionsMutex; // guards connections, only taken when a connection opens or closes
+    std::unordered_set<Connection*> connections;
+
+    void workerLoop(int epollFd);
+    bool serviceConnection(Connection& connection, unsigned events);
+    bool answerRequests(Connection& connection) const;
+    bool flush(Connection& connection);
+    void closeConnection(Connection* connection);
+    void answer(std::string_view request, std::string& out) const;
+    void appendCourse(const CourseCursor& course, std::string& out) const;
+    void shutdown();
+
+public:
+    static constexpr std::size_t DEFAULT_WORKERS = 4;
+
+    CourseServer(const BinarySearchTree& tree, const PrerequisiteGraph& prerequisites);
+    ~CourseServer(); // destructor, stops serving
+
+    CourseServer(const CourseServer&) = delete;
+    CourseServer& operator=(const CourseServer&) = delete;
+
+    bool start(const std::string& path, std::size_t workerCount = DEFAULT_WORKERS);
+    void run();  // accept connections until stop() is called
+    void stop(); // safe to call from a signal handler
+};
+
+#endif // COURSESERVER_H
@@ -0,0 +1,101 @@
+//=========================================================================
+// Name        : FileWatcher.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Reports when a watched file has been written or replaced
+//=========================================================================
+
+#include "FileWatcher.h"
+
+#include <cstring> // For std::strcmp
+
+#ifdef __linux__
+#include <sys/inotify.h> // For inotify_init1 and inotify_add_watch
+#include <unistd.h>      // For read and close
+#endif
+
+// Constructor.
+FileWatcher::FileWatcher()
+#ifdef __linux__
+    : inotifyFd(-1), watchId(-1)
+#endif
+{
+}
+
+// Destructor.
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+// Start watching a file, replacing any earlier one. Returns false if the file doesn't exist.
+bool FileWatcher::watch(const std::string& path) {
+    stop();
+    std::error_code error;
+    lastWrite = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    filename = path;
+    std::filesystem::path file(path);
+    name = file.filename().string();
+
+#ifdef __linux__
+    // watch the directory, editors often save by writing a new file and renaming it over the old one
+    std::string directory = file.has_parent_path() ? file.parent_path().string() : std::string(".");
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0) {
+        watchId = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (watchId < 0) { // fall back to comparing write times
+            ::close(inotifyFd);
+            inotifyFd = -1;
+        }
+    }
+#endif
+    return true;
+}
+
+// Stop watching.
+void FileWatcher::stop() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        ::close(inotifyFd); // closing the descriptor drops its watch as well
+        inotifyFd = -1;
+        watchId = -1;
+    }
+#endif
+    filename.clear();
+    name.clear();
+}
+
+// Check if the file was written or replaced since the last call.
+bool FileWatcher::changed() {
+    if (!isWatching()) return false;
+
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        bool touched = false;
+        alignas(inotify_event) char buffer[4096];
+        while (true) { // drain every queued event, the descriptor is non-blocking
+            ssize_t bytes = ::read(inotifyFd, buffer, sizeof(buffer));
+            if (bytes <= 0) break;
+            for (ssize_t offset = 0; offset < bytes;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if (event->len > 0 && std::strcmp(event->name, name.c_str()) == 0) {
+                    touched = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return touched;
+    }
+#endif
+
+    std::error_code error;
+    std::filesystem::file_time_type written = std::filesystem::last_write_time(filename, error);
+    if (error || written == lastWrite) {
+        return false; // missing while it is being replaced, or untouched
+    }
+    lastWrite = written;
+    return true;
+}
@@ -0,0 +1,44 @@
+//=========================================================================
+// Name        : FileWatcher.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Reports when a watched file has been written or replaced
+//=========================================================================
+
+#pragma once
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <filesystem>
+#include <string>
+
+// FileWatcher tells the planner when the courses file changed since it last asked.
+// On Linux it uses inotify on the file's directory, so saves that replace the file
+// through a rename are seen too. Elsewhere it compares the file's write time.
+// changed() never blocks.
+class FileWatcher {
+private:
+    std::string filename;
+    std::string name; // file name inside its directory, as inotify reports it
+#ifdef __linux__
+    int inotifyFd; // -1 when not watching
+    int watchId;
+#endif
+    std::filesystem::file_time_type lastWrite; // the write time seen last, for the fallback
+
+public:
+    FileWatcher(); // constructor
+    ~FileWatcher(); // destructor, stops watching
+
+    // the watcher owns an inotify descriptor, so it can't be copied
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool watch(const std::string& path);
+    void stop();
+    bool isWatching() const { return !filename.empty(); }
+    bool changed();
+};
+
+#endif // FILEWATCHER_H
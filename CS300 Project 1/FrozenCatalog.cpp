@@ -0,0 +1,275 @@
+//=========================================================================
+// Name        : FrozenCatalog.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Read-only flat snapshot of the course tree in Eytzinger order
+//=========================================================================
+
+#include "FrozenCatalog.h"
+#include "BinarySearchTree.h"
+
+#include <cstring>    // For std::memcpy
+#include <filesystem> // For the size and time of the csv a snapshot was built from
+#include <fstream>    // For writing snapshot files
+
+// layout of a snapshot file: this header, then the course array, the prerequisite array and
+// the text block, each starting on an 8 byte boundary so the arrays can be used where they are mapped
+struct SnapshotHeader {
+    char magic[8];               // "CS300CAT"
+    std::uint32_t version;       // SNAPSHOT_VERSION, bumped whenever the layout changes
+    std::uint32_t byteOrder;     // BYTE_ORDER_MARK as written, so files from the other endianness are refused
+    std::uint64_t slotCount;     // entries in the course array, including the unused slot 0
+    std::uint64_t prereqCount;   // entries in the prerequisite array
+    std::uint64_t textBytes;     // bytes in the text block
+    std::uint64_t checksum;      // checksum of everything after the header
+    std::uint64_t sourceBytes;   // size of the csv the snapshot was built from
+    std::int64_t sourceModified; // and its modification time, in ticks of the file clock
+};
+
+static const char SNAPSHOT_MAGIC[8] = { 'C', 'S', '3', '0', '0', 'C', 'A', 'T' };
+static const std::uint32_t SNAPSHOT_VERSION = 2;
+static const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Round a byte count up to the next multiple of 8.
+static std::size_t alignUp(std::size_t bytes) {
+    return (bytes + 7) & ~static_cast<std::size_t>(7);
+}
+
+// Checksum the bytes 8 at a time, a multiply-xorshift mix per word keeps it close to memory speed.
+static std::uint64_t checksumOf(const char* data, std::size_t length) {
+    std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ length;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    for (; i < length; ++i) { // the last few bytes one at a time
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0xFF51AFD7ED558CCDull;
+    }
+    return hash;
+}
+
+// Read the size and modification time of a file.
+bool SnapshotSource::of(const std::string& filename, SnapshotSource& source) {
+    std::error_code error;
+    std::uintmax_t bytes = std::filesystem::file_size(filename, error);
+    if (error) return false;
+    auto modified = std::filesystem::last_write_time(filename, error);
+    if (error) return false;
+    source.bytes = static_cast<std::uint64_t>(bytes);
+    source.modified = static_cast<std::int64_t>(modified.time_since_epoch().count());
+    return true;
+}
+
+// Check that a header was written by this build: the magic, the layout version and the byte order.
+static bool headerMatchesBuild(const SnapshotHeader& header) {
+    return std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0
+        && header.version == SNAPSHOT_VERSION && header.byteOrder == BYTE_ORDER_MARK;
+}
+
+// Constructor.
+FrozenCatalog::FrozenCatalog()
+    : courses(nullptr), prerequisites(nullptr), text(nullptr), slotCount(0), prereqTotal(0), textBytes(0) {}
+
+// Pack the first 8 bytes of a course number into an integer whose order matches string order.
+// Shorter numbers are padded with zero bytes, which sort before any real character.
+std::uint64_t FrozenCatalog::packKey(std::string_view courseNumber) {
+    return StringPool::packKey(courseNumber); // same packing the tree's pool uses
+}
+
+// Append a string to the shared text block.
+FrozenString FrozenCatalog::addText(std::string_view str) {
+    FrozenString ref = { static_cast<std::uint32_t>(ownedText.size()), static_cast<std::uint32_t>(str.size()) };
+    ownedText.append(str.data(), str.size());
+    return ref;
+}
+
+// Build the snapshot from courses already in sorted order.
+void FrozenCatalog::build(const std::vector<const CourseRecord*>& sorted, const BinarySearchTree& bst) {
+    clear();
+    std::size_t n = sorted.size();
+    ownedCourses.resize(n + 1);
+    courses = ownedCourses.data();
+    slotCount = n + 1;
+
+    // an in-order walk of the implicit tree visits slots in sorted order,
+    // so hand out the sorted courses in that walk
+    std::size_t next = 0;
+    for (std::size_t slot = firstSlot(); slot != 0; slot = nextSlot(slot)) {
+        const CourseRecord& course = *sorted[next++];
+        FrozenCourse& entry = ownedCourses[slot];
+        entry.key = course.key;
+        entry.number = addText(bst.numberOf(course));
+        entry.title = addText(bst.titleOf(course));
+        entry.prereqFirst = static_cast<std::uint32_t>(ownedPrerequisites.size());
+        entry.prereqCount = course.prereqCount;
+        for (std::size_t i = 0; i < course.prereqCount; ++i) {
+            ownedPrerequisites.push_back(addText(bst.pool().nameOf(bst.prerequisiteOf(course, i))));
+        }
+    }
+    prerequisites = ownedPrerequisites.data(); // the vectors are complete, so the pointers stay valid
+    text = ownedText.data();
+    prereqTotal = ownedPrerequisites.size();
+    textBytes = ownedText.size();
+}
+
+// Drop the catalog, whether it was built or mapped.
+void FrozenCatalog::clear() {
+    ownedCourses.clear();
+    ownedPrerequisites.clear();
+    ownedText.clear();
+    mapping.close();
+    courses = nullptr;
+    prerequisites = nullptr;
+    text = nullptr;
+    slotCount = 0;
+    prereqTotal = 0;
+    textBytes = 0;
+}
+
+// Write the catalog to a snapshot file, in the layout load() maps back.
+bool FrozenCatalog::save(const std::string& filename, const SnapshotSource& source) const {
+    if (isEmpty()) return false;
+
+    // lay the body out in memory first, so the checksum can go in the header
+    std::size_t coursesBytes = alignUp(slotCount * sizeof(FrozenCourse));
+    std::size_t prereqBytes = alignUp(prereqTotal * sizeof(FrozenString));
+    std::string body(coursesBytes + prereqBytes + alignUp(textBytes), '\0');
+    std::memcpy(&body[0], courses, slotCount * sizeof(FrozenCourse));
+    if (prereqTotal > 0) std::memcpy(&body[coursesBytes], prerequisites, prereqTotal * sizeof(FrozenString));
+    if (textBytes > 0) std::memcpy(&body[coursesBytes + prereqBytes], text, textBytes);
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.slotCount = slotCount;
+    header.prereqCount = prereqTotal;
+    header.textBytes = textBytes;
+    header.checksum = checksumOf(body.data(), body.size());
+    header.sourceBytes = source.bytes;
+    header.sourceModified = source.modified;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false; // return false if the file can't be created
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(body.data(), static_cast<std::streamsize>(body.size()));
+    return file.good();
+}
+
+// Read the source recorded in a snapshot's header, false if the file isn't a snapshot this build wrote.
+bool FrozenCatalog::sourceOf(const std::string& filename, SnapshotSource& source) {
+    std::ifstream file(filename, std::ios::binary);
+    SnapshotHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !headerMatchesBuild(header)) {
+        return false;
+    }
+    source.bytes = header.sourceBytes;
+    source.modified = header.sourceModified;
+    return true;
+}
+
+// Map a snapshot file and point the arrays into it. The header, the source it was built from and
+// the checksum are verified, anything that doesn't match leaves the catalog empty and returns false.
+bool FrozenCatalog::load(const std::string& filename, const SnapshotSource& source) {
+    clear();
+    MappedFile file;
+    if (!file.open(filename) || file.size() < sizeof(SnapshotHeader)) {
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!headerMatchesBuild(header) || header.slotCount < 2) {
+        return false; // not a snapshot, or one written by a different build
+    }
+    if (header.sourceBytes != source.bytes || header.sourceModified != source.modified) {
+        return false; // built from another version of the csv
+    }
+    std::size_t coursesBytes = alignUp(header.slotCount * sizeof(FrozenCourse));
+    std::size_t prereqBytes = alignUp(header.prereqCount * sizeof(FrozenString));
+    std::size_t bodyBytes = coursesBytes + prereqBytes + alignUp(header.textBytes);
+    if (file.size() != sizeof(SnapshotHeader) + bodyBytes) {
+        return false; // truncated or padded
+    }
+    const char* body = file.data() + sizeof(SnapshotHeader);
+    if (checksumOf(body, bodyBytes) != header.checksum) {
+        return false; // damaged
+    }
+
+    // the mapping is page aligned and the header is a multiple of 8 bytes, so every array is aligned
+    mapping = std::move(file);
+    courses = reinterpret_cast<const FrozenCourse*>(body);
+    prerequisites = reinterpret_cast<const FrozenString*>(body + coursesBytes);
+    text = body + coursesBytes + prereqBytes;
+    slotCount = static_cast<std::size_t>(header.slotCount);
+    prereqTotal = static_cast<std::size_t>(header.prereqCount);
+    textBytes = static_cast<std::size_t>(header.textBytes);
+    return true;
+}
+
+// Slot holding the smallest course, or 0 when empty.
+std::size_t FrozenCatalog::firstSlot() const {
+    std::size_t n = size();
+    if (n == 0) return 0;
+    std::size_t slot = 1;
+    while (slot * 2 <= n) slot *= 2; // keep going left
+    return slot;
+}
+
+// In-order successor of a slot, or 0 after the last one.
+std::size_t FrozenCatalog::nextSlot(std::size_t slot) const {
+    std::size_t n = size();
+    if (slot * 2 + 1 <= n) { // smallest slot in the right subtree
+        slot = slot * 2 + 1;
+        while (slot * 2 <= n) slot *= 2;
+        return slot;
+    }
+    while (slot & 1) slot >>= 1; // climb while we are a right child
+    return slot >> 1;            // then one more step up, 0 past the root
+}
+
+// Find a course by its (already uppercase) number, returning its slot or 0.
+std::size_t FrozenCatalog::find(std::string_view courseNumber) const {
+    std::size_t slot = bound(courseNumber, false);
+    if (slot != 0 && numberOf(slot) == courseNumber) return slot;
+    return 0;
+}
+
+// Slot of the first course whose (already uppercase) number is not before courseNumber,
+// or with after set, the first one that sorts after it. 0 when there is none.
+std::size_t FrozenCatalog::bound(std::string_view courseNumber, bool after) const {
+    std::size_t n = size();
+    std::uint64_t key = packKey(courseNumber);
+
+    // branchless descent: go right when the slot's number comes before the bound, the comparison result is the step.
+    // numbers longer than 8 bytes can share a key, only then are the full strings compared
+    std::size_t slot = 1;
+    while (slot <= n) {
+        const FrozenCourse& entry = courses[slot];
+        bool goRight = entry.key < key
+            || (entry.key == key && (after ? numberOf(slot) <= courseNumber : numberOf(slot) < courseNumber));
+        slot = 2 * slot + goRight;
+    }
+    // the bound is the last slot where we went left
+    while (slot & 1) slot >>= 1;
+    return slot >> 1;
+}
+
+std::string_view FrozenCatalog::numberOf(std::size_t slot) const {
+    return std::string_view(text + courses[slot].number.offset, courses[slot].number.length);
+}
+
+std::string_view FrozenCatalog::titleOf(std::size_t slot) const {
+    return std::string_view(text + courses[slot].title.offset, courses[slot].title.length);
+}
+
+std::string_view FrozenCatalog::prerequisiteOf(std::size_t slot, std::size_t i) const {
+    const FrozenString& ref = prerequisites[courses[slot].prereqFirst + i];
+    return std::string_view(text + ref.offset, ref.length);
+}
@@ -0,0 +1,116 @@
+//=========================================================================
+// Name        : FrozenCatalog.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Read-only flat snapshot of the course tree in Eytzinger order
+//=========================================================================
+
+#pragma once
+#ifndef FROZENCATALOG_H
+#define FROZENCATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+struct CourseRecord;
+class BinarySearchTree;
+
+// the csv a snapshot was built from, its size and modification time taken before the parse
+// started. A snapshot only stands in for the csv while both still match exactly.
+struct SnapshotSource {
+    std::uint64_t bytes;
+    std::int64_t modified; // ticks of the file clock, only ever compared for equality
+
+    static bool of(const std::string& filename, SnapshotSource& source); // false if the file can't be read
+    bool operator==(const SnapshotSource& other) const { return bytes == other.bytes && modified == other.modified; }
+    bool operator!=(const SnapshotSource& other) const { return !(*this == other); }
+};
+
+// a string stored in the catalog's shared text block
+struct FrozenString {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+// one course in the flat layout, fixed size so the array stays dense
+struct FrozenCourse {
+    std::uint64_t key;         // first 8 bytes of the course number, big-endian, compared as one integer
+    FrozenString number;       // full course number
+    FrozenString title;        // course title
+    std::uint32_t prereqFirst; // first entry in the prerequisites array
+    std::uint32_t prereqCount; // number of prerequisites
+};
+
+// FrozenCatalog is the catalog compiled into a contiguous array laid out in
+// Eytzinger (breadth-first) order: slot 1 is the root and slot k has its children
+// at 2k and 2k+1. A lookup touches one cache line per level near the top of the
+// tree and needs no pointers at all.
+// The three arrays are either built in memory or mapped straight from a snapshot
+// file written by save(), lookups read them the same way in both cases.
+class FrozenCatalog {
+private:
+    // arrays owned by a catalog built in memory
+    std::vector<FrozenCourse> ownedCourses;       // slot 0 is unused, slots 1..n hold the courses
+    std::vector<FrozenString> ownedPrerequisites; // prerequisite numbers, grouped per course
+    std::string ownedText;                        // every string, back to back
+    MappedFile mapping;                           // snapshot file, when the arrays come from one
+
+    // the arrays lookups read, pointing into the owned arrays or into the mapping
+    const FrozenCourse* courses;
+    const FrozenString* prerequisites;
+    const char* text;
+    std::size_t slotCount;   // entries in courses, including the unused slot 0
+    std::size_t prereqTotal; // entries in prerequisites
+    std::size_t textBytes;   // bytes in text
+
+    FrozenString addText(std::string_view str);
+
+public:
+    static std::uint64_t packKey(std::string_view courseNumber);
+
+    FrozenCatalog();
+
+    // the arrays may point into the catalog's own vectors, so it can't be copied
+    FrozenCatalog(const FrozenCatalog&) = delete;
+    FrozenCatalog& operator=(const FrozenCatalog&) = delete;
+
+    void build(const std::vector<const CourseRecord*>& sorted, const BinarySearchTree& bst);
+    void clear();
+    bool isEmpty() const { return slotCount <= 1; }
+    bool isMapped() const { return mapping.data() != nullptr; }
+    std::size_t size() const { return slotCount == 0 ? 0 : slotCount - 1; }
+
+    // snapshot files, load() maps the file and checks it without parsing any record,
+    // refusing a snapshot built from a different version of the csv
+    bool save(const std::string& filename, const SnapshotSource& source) const;
+    bool load(const std::string& filename, const SnapshotSource& source);
+    static bool sourceOf(const std::string& filename, SnapshotSource& source); // the source recorded in a snapshot's header
+
+    std::size_t find(std::string_view courseNumber) const; // 0 when not found
+    std::size_t bound(std::string_view courseNumber, bool after) const; // first slot at (or after) the number, 0 past the end
+
+    // walk the slots in sorted order, 0 when there are no more
+    std::size_t firstSlot() const;
+    std::size_t nextSlot(std::size_t slot) const;
+
+    // access to a slot returned by find or by the in-order walk
+    std::string_view numberOf(std::size_t slot) const;
+    std::string_view titleOf(std::size_t slot) const;
+    std::size_t prerequisiteCount(std::size_t slot) const { return courses[slot].prereqCount; }
+    std::string_view prerequisiteOf(std::size_t slot, std::size_t i) const;
+
+    // visit every slot in sorted order
+    template <typename Visitor>
+    void forEachInOrder(Visitor visit) const {
+        for (std::size_t slot = firstSlot(); slot != 0; slot = nextSlot(slot)) {
+            visit(slot);
+        }
+    }
+};
+
+#endif // FROZENCATALOG_H
@@ -0,0 +1,58 @@
+//=========================================================================
+// Name        : KioskCatalog.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Description : Catalog compiled from courses.csv, generated by --generate-catalog, do not edit
+//=========================================================================
+
+#pragma once
+#ifndef KIOSKCATALOG_H
+#define KIOSKCATALOG_H
+
+#include <cstdint>
+#include <string_view>
+#include "StaticCatalog.h"
+
+namespace KioskCatalog {
+
+using namespace std::string_view_literals;
+
+// 8 courses in sorted order
+inline constexpr StaticCourse COURSES[] = {
+    { "CSCI100"sv, "Introduction to Computer Science"sv, 0, 0 },
+    { "CSCI101"sv, "Introduction to Programming in C++"sv, 0, 1 },
+    { "CSCI200"sv, "Data Structures"sv, 1, 1 },
+    { "CSCI300"sv, "Introduction to Algorithms"sv, 2, 2 },
+    { "CSCI301"sv, "Advanced Programming in C++"sv, 4, 1 },
+    { "CSCI350"sv, "Operating Systems"sv, 5, 1 },
+    { "CSCI400"sv, "Large Software Development"sv, 6, 2 },
+    { "MATH201"sv, "Discrete Mathematics"sv, 8, 0 },
+};
+
+// prerequisites resolved to their course, the number alone when the catalog doesn't list it
+inline constexpr StaticPrerequisite PREREQUISITES[] = {
+    { 0, "CSCI100"sv },
+    { 1, "CSCI101"sv },
+    { 2, "CSCI200"sv },
+    { 7, "MATH201"sv },
+    { 1, "CSCI101"sv },
+    { 3, "CSCI300"sv },
+    { 4, "CSCI301"sv },
+    { 5, "CSCI350"sv },
+};
+
+// perfect hash: a number's bucket seed sends it to its slot, the slot holds its course
+inline constexpr std::uint32_t SEEDS[] = {
+    5, 1, 38,
+};
+
+inline constexpr std::uint32_t SLOTS[] = {
+    7, 1, 4, 0, 2, 6, 3, 5,
+};
+
+inline constexpr StaticCatalog CATALOG(COURSES, PREREQUISITES, SEEDS, SLOTS);
+static_assert(CATALOG.findsEveryCourse(), "the perfect hash must find every course");
+
+} // namespace KioskCatalog
+
+#endif // KIOSKCATALOG_H
@@ -0,0 +1,138 @@
+//=========================================================================
+// Name        : MappedFile.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Read-only memory-mapped file wrapper used by the course loaders
+//=========================================================================
+
+#include "MappedFile.h"
+
+#include <utility> // For std::swap
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Constructor.
+#ifdef _WIN32
+MappedFile::MappedFile() : bytes(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : bytes(nullptr), length(0) {}
+#endif
+
+// Destructor.
+MappedFile::~MappedFile() {
+    close(); // release the view and any handles still held
+}
+
+// Move constructor, takes over the other mapping and leaves it closed.
+MappedFile::MappedFile(MappedFile&& other) noexcept : MappedFile() {
+    *this = std::move(other);
+}
+
+// Move assignment, swaps mappings so the old one is released by other's destructor.
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        std::swap(bytes, other.bytes);
+        std::swap(length, other.length);
+#ifdef _WIN32
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#endif
+    }
+    return *this;
+}
+
+// Map the whole file read-only. An empty file opens successfully with size 0.
+bool MappedFile::open(const std::string& filename) {
+    close(); // drop any previous mapping first
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false; // return false if the file can't be opened
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    if (fileSize.QuadPart == 0) {
+        return true; // nothing to map, but the file exists
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        close();
+        return false;
+    }
+    bytes = static_cast<const char*>(view);
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false; // return false if the file can't be opened
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        return true; // nothing to map, but the file exists
+    }
+
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps its own reference to the file
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL); // the loaders scan front to back
+    bytes = static_cast<const char*>(view);
+    length = static_cast<std::size_t>(info.st_size);
+#endif
+    return true;
+}
+
+// Unmap the view and release the handles.
+void MappedFile::close() {
+#ifdef _WIN32
+    if (bytes != nullptr) {
+        UnmapViewOfFile(bytes);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    if (bytes != nullptr) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+#endif
+    bytes = nullptr;
+    length = 0;
+}
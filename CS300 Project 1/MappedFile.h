@@ -0,0 +1,46 @@
+//=========================================================================
+// Name        : MappedFile.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Read-only memory-mapped file wrapper used by the course loaders
+//=========================================================================
+
+#pragma once
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// MappedFile maps a whole file into memory read-only so it can be scanned
+// in place without copying it into std::string buffers first.
+class MappedFile {
+private:
+    const char* bytes;  // start of the mapped view (nullptr when closed)
+    std::size_t length; // number of bytes in the view
+#ifdef _WIN32
+    void* fileHandle;    // HANDLE returned by CreateFileA
+    void* mappingHandle; // HANDLE returned by CreateFileMappingA
+#endif
+
+public:
+    MappedFile(); // constructor
+    ~MappedFile(); // destructor, unmaps the file
+
+    // a mapping owns OS handles, so it can be moved but not copied
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& filename);
+    void close();
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(bytes, length); }
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,305 @@
+//=========================================================================
+// Name        : PrerequisiteGraph.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Compiled prerequisite graph with transitive closure bitsets
+//=========================================================================
+
+#include "PrerequisiteGraph.h"
+#include "BinarySearchTree.h"
+
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h> // For _BitScanForward64
+#endif
+
+// Index of the lowest set bit in a non-zero word.
+static std::size_t lowestBit(std::uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return index;
+#else
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#endif
+}
+
+// Constructor.
+PrerequisiteGraph::PrerequisiteGraph() : words(0), closureBudget(DEFAULT_CLOSURE_BUDGET), lazyBytes(0), cyclic(false) {}
+
+// Destructor.
+PrerequisiteGraph::~PrerequisiteGraph() {
+    dropLazyRows();
+}
+
+// Free the rows kept from queries.
+void PrerequisiteGraph::dropLazyRows() {
+    for (std::atomic<std::uint64_t*>* rows : { lazyAncestors.get(), lazyDescendants.get() }) {
+        if (rows == nullptr) continue;
+        for (std::size_t v = 0; v < names.size(); ++v) {
+            delete[] rows[v].load();
+        }
+    }
+    lazyAncestors.reset();
+    lazyDescendants.reset();
+    lazyBytes = 0;
+}
+
+// Drop the graph.
+void PrerequisiteGraph::clear() {
+    dropLazyRows(); // before names, it tells how many rows there are
+    names.clear();
+    inCatalog.clear();
+    prereqStart.clear();
+    prereqEdges.clear();
+    dependentStart.clear();
+    dependentEdges.clear();
+    ancestorBits.clear();
+    descendantBits.clear();
+    words = 0;
+    cyclic = false;
+}
+
+// Find the vertex for a course number, or NOT_FOUND.
+std::size_t PrerequisiteGraph::idOf(std::string_view courseNumber) const {
+    auto it = std::lower_bound(names.begin(), names.end(), courseNumber,
+        [](const std::string& name, std::string_view key) { return std::string_view(name) < key; });
+    if (it == names.end() || *it != courseNumber) return NOT_FOUND;
+    return static_cast<std::size_t>(it - names.begin());
+}
+
+// Compile the graph from the loaded courses.
+void PrerequisiteGraph::build(const BinarySearchTree& bst, std::size_t closureBudgetBytes) {
+    clear();
+    closureBudget = closureBudgetBytes;
+
+    // every interned course number becomes a vertex, sorted so vertices follow catalog order
+    const StringPool& pool = bst.pool();
+    std::vector<CourseId> sortedIds(pool.size());
+    for (CourseId id = 0; id < sortedIds.size(); ++id) sortedIds[id] = id;
+    std::sort(sortedIds.begin(), sortedIds.end(), [&pool](CourseId a, CourseId b) { return pool.less(a, b); });
+
+    std::size_t n = sortedIds.size();
+    std::vector<std::uint32_t> vertexOf(n); // pool id -> vertex
+    names.reserve(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        vertexOf[sortedIds[v]] = static_cast<std::uint32_t>(v);
+        names.emplace_back(pool.nameOf(sortedIds[v]));
+    }
+    inCatalog.assign(n, false);
+
+    // forward CSR, one row per vertex, prerequisites resolved to vertex ids
+    prereqStart.assign(n + 1, 0);
+    std::vector<std::uint32_t> dependentCount(n, 0);
+    bst.forEachCourse([&](const CourseRecord& course) {
+        std::size_t vertex = vertexOf[course.number];
+        inCatalog[vertex] = true;
+        prereqStart[vertex + 1] = course.prereqCount;
+    });
+    for (std::size_t v = 0; v < n; ++v) {
+        prereqStart[v + 1] += prereqStart[v]; // prefix sum turns counts into offsets
+    }
+    prereqEdges.resize(prereqStart[n]);
+    bst.forEachCourse([&](const CourseRecord& course) {
+        std::uint32_t at = prereqStart[vertexOf[course.number]];
+        for (std::size_t i = 0; i < course.prereqCount; ++i) {
+            std::uint32_t target = vertexOf[bst.prerequisiteOf(course, i)];
+            prereqEdges[at++] = target;
+            ++dependentCount[target];
+        }
+    });
+
+    // reverse CSR, built from the forward edges
+    dependentStart.assign(n + 1, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        dependentStart[v + 1] = dependentStart[v] + dependentCount[v];
+    }
+    dependentEdges.resize(dependentStart[n]);
+    std::vector<std::uint32_t> fill(dependentStart.begin(), dependentStart.end() - 1);
+    for (std::size_t v = 0; v < n; ++v) {
+        for (std::uint32_t e = prereqStart[v]; e < prereqStart[v + 1]; ++e) {
+            dependentEdges[fill[prereqEdges[e]]++] = static_cast<std::uint32_t>(v);
+        }
+    }
+
+    words = (n + 63) / 64;
+    if (2 * n * words * sizeof(std::uint64_t) <= closureBudget) {
+        buildClosure();
+    }
+    else { // rows are filled as they are asked for, the topological sort alone tells us about cycles
+        std::vector<std::uint32_t> order;
+        cyclic = !topologicalOrder(order);
+        lazyAncestors.reset(new std::atomic<std::uint64_t*>[n]);
+        lazyDescendants.reset(new std::atomic<std::uint64_t*>[n]);
+        for (std::size_t v = 0; v < n; ++v) {
+            lazyAncestors[v].store(nullptr, std::memory_order_relaxed);
+            lazyDescendants[v].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Kahn's algorithm, prerequisites come before the courses that need them.
+// Vertices on or behind a cycle never become ready and are left out.
+// Returns true when every vertex made it into the order.
+bool PrerequisiteGraph::topologicalOrder(std::vector<std::uint32_t>& order) const {
+    std::size_t n = names.size();
+    order.clear();
+    order.reserve(n);
+    std::vector<std::uint32_t> remaining(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        remaining[v] = prereqStart[v + 1] - prereqStart[v];
+        if (remaining[v] == 0) order.push_back(static_cast<std::uint32_t>(v));
+    }
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        std::uint32_t v = order[i];
+        for (std::uint32_t e = dependentStart[v]; e < dependentStart[v + 1]; ++e) {
+            if (--remaining[dependentEdges[e]] == 0) order.push_back(dependentEdges[e]);
+        }
+    }
+    return order.size() == n;
+}
+
+// OR row from into row to, and set the bit for from itself.
+void PrerequisiteGraph::mergeRow(std::vector<std::uint64_t>& bits, std::size_t to, std::size_t from) const {
+    std::uint64_t* row = &bits[to * words];
+    const std::uint64_t* other = &bits[from * words];
+    for (std::size_t w = 0; w < words; ++w) row[w] |= other[w];
+    row[from / 64] |= std::uint64_t(1) << (from % 64);
+}
+
+// Fill both closure directions. Vertices are processed in topological order so
+// each row is the OR of its neighbours' rows plus the neighbours themselves.
+// Vertices left out of the order sit on or behind a cycle, their rows are filled
+// first by walking the graph so the merges below can rely on them.
+void PrerequisiteGraph::buildClosure() {
+    std::size_t n = names.size();
+    ancestorBits.assign(n * words, 0);
+    descendantBits.assign(n * words, 0);
+
+    std::vector<std::uint32_t> order;
+    cyclic = !topologicalOrder(order);
+    if (cyclic) {
+        std::vector<bool> ordered(n, false);
+        for (std::uint32_t v : order) ordered[v] = true;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (!ordered[v]) {
+                walk(v, prereqStart, prereqEdges, &ancestorBits[v * words]);
+                walk(v, dependentStart, dependentEdges, &descendantBits[v * words]);
+            }
+        }
+    }
+
+    // prerequisites: forward through the order, an ordered vertex only has ordered prerequisites
+    for (std::uint32_t v : order) {
+        for (std::uint32_t e = prereqStart[v]; e < prereqStart[v + 1]; ++e) {
+            mergeRow(ancestorBits, v, prereqEdges[e]);
+        }
+    }
+    // dependents: backward through the order, rows of unordered dependents are already complete
+    for (std::size_t i = order.size(); i-- > 0;) {
+        std::uint32_t v = order[i];
+        for (std::uint32_t e = dependentStart[v]; e < dependentStart[v + 1]; ++e) {
+            mergeRow(descendantBits, v, dependentEdges[e]);
+        }
+    }
+}
+
+// Depth-first walk from vertex along one CSR direction, setting a bit for every vertex reached.
+void PrerequisiteGraph::walk(std::size_t vertex, const std::vector<std::uint32_t>& start,
+    const std::vector<std::uint32_t>& edges, std::uint64_t* row) const {
+    std::vector<std::uint32_t> stack(1, static_cast<std::uint32_t>(vertex));
+    while (!stack.empty()) {
+        std::uint32_t v = stack.back();
+        stack.pop_back();
+        for (std::uint32_t e = start[v]; e < start[v + 1]; ++e) {
+            std::uint32_t next = edges[e];
+            std::uint64_t bit = std::uint64_t(1) << (next % 64);
+            if ((row[next / 64] & bit) == 0) { // first time we reach it
+                row[next / 64] |= bit;
+                stack.push_back(next);
+            }
+        }
+    }
+}
+
+// One direction's closure row for a vertex: the row built with the graph, the one kept from an
+// earlier query, or a new one filled by walking the graph and kept while the budget allows.
+// nullptr once the budget is used up. Two threads may fill the same row, the first one to
+// publish it wins and the other frees its copy.
+const std::uint64_t* PrerequisiteGraph::closureRow(std::size_t vertex, const std::vector<std::uint64_t>& bits, std::atomic<std::uint64_t*>* lazyRows,
+    const std::vector<std::uint32_t>& start, const std::vector<std::uint32_t>& edges) const {
+    if (!bits.empty()) return &bits[vertex * words];
+    if (lazyRows == nullptr) return nullptr;
+    std::uint64_t* row = lazyRows[vertex].load(std::memory_order_acquire);
+    if (row != nullptr) return row;
+
+    std::size_t rowBytes = words * sizeof(std::uint64_t);
+    if (lazyBytes.fetch_add(rowBytes) + rowBytes > closureBudget) { // over budget, don't keep it
+        lazyBytes.fetch_sub(rowBytes);
+        return nullptr;
+    }
+    std::uint64_t* filled = new std::uint64_t[words]();
+    walk(vertex, start, edges, filled);
+    if (lazyRows[vertex].compare_exchange_strong(row, filled, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return filled;
+    }
+    delete[] filled; // row now holds the one another thread published
+    lazyBytes.fetch_sub(rowBytes);
+    return row;
+}
+
+// Decode a closure row into vertex ids, walking the graph when there is no row.
+std::vector<std::size_t> PrerequisiteGraph::collect(std::size_t vertex, const std::uint64_t* row,
+    const std::vector<std::uint32_t>& start, const std::vector<std::uint32_t>& edges) const {
+    std::vector<std::uint64_t> scratch;
+    if (row == nullptr) {
+        scratch.assign(words, 0);
+        walk(vertex, start, edges, scratch.data());
+        row = scratch.data();
+    }
+
+    std::vector<std::size_t> result;
+    for (std::size_t w = 0; w < words; ++w) {
+        for (std::uint64_t word = row[w]; word != 0; word &= word - 1) { // clear the lowest set bit each step
+            result.push_back(w * 64 + lowestBit(word));
+        }
+    }
+    return result;
+}
+
+// Every course that must be completed before this one.
+std::vector<std::size_t> PrerequisiteGraph::allPrerequisites(std::size_t vertex) const {
+    return collect(vertex, prerequisiteRow(vertex), prereqStart, prereqEdges);
+}
+
+// Every course that needs this one, directly or indirectly.
+std::vector<std::size_t> PrerequisiteGraph::allDependents(std::size_t vertex) const {
+    return collect(vertex, dependentRow(vertex), dependentStart, dependentEdges);
+}
+
+// Check if prerequisite is needed, directly or indirectly, before course.
+bool PrerequisiteGraph::dependsOn(std::size_t course, std::size_t prerequisite) const {
+    const std::uint64_t* row = prerequisiteRow(course);
+    if (row != nullptr) {
+        return (row[prerequisite / 64] >> (prerequisite % 64)) & 1;
+    }
+    std::vector<std::uint64_t> scratch(words, 0);
+    walk(course, prereqStart, prereqEdges, scratch.data());
+    return (scratch[prerequisite / 64] >> (prerequisite % 64)) & 1;
+}
+
+// A course is on a cycle when it ends up among its own prerequisites.
+bool PrerequisiteGraph::isOnCycle(std::size_t vertex) const {
+    return cyclic && dependsOn(vertex, vertex);
+}
+
+// Closure row of every prerequisite of a vertex, nullptr once the budget is used up.
+const std::uint64_t* PrerequisiteGraph::prerequisiteRow(std::size_t vertex) const {
+    return closureRow(vertex, ancestorBits, lazyAncestors.get(), prereqStart, prereqEdges);
+}
+
+// Closure row of every dependent of a vertex, nullptr once the budget is used up.
+const std::uint64_t* PrerequisiteGraph::dependentRow(std::size_t vertex) const {
+    return closureRow(vertex, descendantBits, lazyDescendants.get(), dependentStart, dependentEdges);
+}
@@ -0,0 +1,103 @@
+//=========================================================================
+// Name        : PrerequisiteGraph.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Compiled prerequisite graph with transitive closure bitsets
+//=========================================================================
+
+#pragma once
+#ifndef PREREQUISITEGRAPH_H
+#define PREREQUISITEGRAPH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class BinarySearchTree;
+
+// PrerequisiteGraph is built once after loading. Every course number, including
+// prerequisites that aren't in the catalog, becomes a vertex numbered in sorted order.
+// Edges are stored in CSR form both ways (course -> its prerequisites, and
+// course -> the courses that list it), and each vertex gets two bitset rows with
+// its full transitive prerequisites and dependents.
+// Closure rows cost n*n/8 bytes per direction. While both directions fit in the
+// closure budget they are all built with the graph. Past it a row is filled by
+// walking the graph on its first query and kept for the next one, until the kept
+// rows reach the budget; after that queries walk the CSR arrays. Kept rows are
+// published atomically, so queries from several threads can share them.
+class PrerequisiteGraph {
+public:
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+    static constexpr std::size_t DEFAULT_CLOSURE_BUDGET = std::size_t(64) << 20; // bytes of closure rows, both directions
+
+private:
+    std::vector<std::string> names;        // vertex -> course number, sorted
+    std::vector<bool> inCatalog;           // false for prerequisites with no course row
+    std::vector<std::uint32_t> prereqStart; // CSR offsets into prereqEdges, size n+1
+    std::vector<std::uint32_t> prereqEdges; // direct prerequisites of each vertex
+    std::vector<std::uint32_t> dependentStart; // CSR offsets into dependentEdges, size n+1
+    std::vector<std::uint32_t> dependentEdges; // courses that directly list each vertex
+    std::size_t words;                         // 64-bit words per bitset row
+    std::vector<std::uint64_t> ancestorBits;   // row v = every course needed before v, when built with the graph
+    std::vector<std::uint64_t> descendantBits; // row v = every course that needs v
+    std::unique_ptr<std::atomic<std::uint64_t*>[]> lazyAncestors;   // rows filled on first query, nullptr until then
+    std::unique_ptr<std::atomic<std::uint64_t*>[]> lazyDescendants;
+    std::size_t closureBudget;
+    mutable std::atomic<std::size_t> lazyBytes; // bytes in the rows kept so far
+    bool cyclic;
+
+    bool topologicalOrder(std::vector<std::uint32_t>& order) const;
+    void mergeRow(std::vector<std::uint64_t>& bits, std::size_t to, std::size_t from) const;
+    void buildClosure();
+    void walk(std::size_t vertex, const std::vector<std::uint32_t>& start,
+        const std::vector<std::uint32_t>& edges, std::uint64_t* row) const;
+    const std::uint64_t* closureRow(std::size_t vertex, const std::vector<std::uint64_t>& bits, std::atomic<std::uint64_t*>* lazyRows,
+        const std::vector<std::uint32_t>& start, const std::vector<std::uint32_t>& edges) const;
+    std::vector<std::size_t> collect(std::size_t vertex, const std::uint64_t* row,
+        const std::vector<std::uint32_t>& start, const std::vector<std::uint32_t>& edges) const;
+    void dropLazyRows();
+
+public:
+    PrerequisiteGraph();
+    ~PrerequisiteGraph();
+
+    // kept rows are owned by the graph, so it can't be copied
+    PrerequisiteGraph(const PrerequisiteGraph&) = delete;
+    PrerequisiteGraph& operator=(const PrerequisiteGraph&) = delete;
+
+    void build(const BinarySearchTree& bst, std::size_t closureBudgetBytes = DEFAULT_CLOSURE_BUDGET);
+    void clear();
+
+    std::size_t size() const { return names.size(); }
+    bool hasClosure() const { return !ancestorBits.empty(); } // true when every row was built with the graph
+    std::size_t closureBytes() const { return (ancestorBits.size() + descendantBits.size()) * sizeof(std::uint64_t) + lazyBytes.load(); }
+    std::size_t idOf(std::string_view courseNumber) const;
+    const std::string& nameOf(std::size_t vertex) const { return names[vertex]; }
+    bool isInCatalog(std::size_t vertex) const { return inCatalog[vertex]; }
+
+    // direct edges
+    std::size_t directPrerequisiteCount(std::size_t vertex) const { return prereqStart[vertex + 1] - prereqStart[vertex]; }
+    std::size_t directPrerequisite(std::size_t vertex, std::size_t i) const { return prereqEdges[prereqStart[vertex] + i]; }
+    std::size_t directDependentCount(std::size_t vertex) const { return dependentStart[vertex + 1] - dependentStart[vertex]; }
+    std::size_t directDependent(std::size_t vertex, std::size_t i) const { return dependentEdges[dependentStart[vertex] + i]; }
+
+    // closure queries, results come back in sorted course order
+    std::vector<std::size_t> allPrerequisites(std::size_t vertex) const;
+    std::vector<std::size_t> allDependents(std::size_t vertex) const;
+    bool dependsOn(std::size_t course, std::size_t prerequisite) const;
+    bool isOnCycle(std::size_t vertex) const;
+    bool hasCycle() const { return cyclic; }
+
+    // raw closure rows, filled now if they weren't built with the graph, nullptr once the budget is used up
+    std::size_t wordsPerRow() const { return words; }
+    const std::uint64_t* prerequisiteRow(std::size_t vertex) const;
+    const std::uint64_t* dependentRow(std::size_t vertex) const;
+};
+
+#endif // PREREQUISITEGRAPH_H
@@ -0,0 +1,450 @@
+//=========================================================================
+// Name        : RadixIndex.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Adaptive radix tree from course numbers to the tree's nodes
+//=========================================================================
+
+#include "RadixIndex.h"
+
+#include <algorithm> // For std::min
+#include <cstring>   // For std::memmove and std::memcpy
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RADIX_SSE2
+#include <emmintrin.h> // For the SSE2 intrinsics
+#endif
+#ifdef _MSC_VER
+#include <intrin.h> // For _BitScanForward
+#endif
+
+// Byte of key at depth, the implied zero byte once the key has ended.
+static inline std::uint8_t byteAt(std::string_view key, std::size_t depth) {
+    return depth < key.size() ? static_cast<std::uint8_t>(key[depth]) : 0;
+}
+
+// Index of the lowest set bit, mask is never 0.
+static inline unsigned lowestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Give a grown or shrunk node the prefix of the one it replaces.
+static void copyHeader(RadixNode* to, const RadixNode* from) {
+    to->childCount = from->childCount;
+    to->prefixLength = from->prefixLength;
+    std::memcpy(to->prefix, from->prefix, RadixNode::MAX_PREFIX);
+}
+
+// Constructor.
+RadixIndex::RadixIndex() : root(nullptr), count(0) {}
+
+// Leftmost leaf below node, its key supplies prefix bytes the node doesn't store.
+const RadixLeaf* RadixIndex::minimumLeaf(const RadixNode* node) const {
+    while (node->type != RadixType::Leaf) {
+        switch (node->type) {
+        case RadixType::Node4:
+            node = static_cast<const RadixNode4*>(node)->children[0];
+            break;
+        case RadixType::Node16:
+            node = static_cast<const RadixNode16*>(node)->children[0];
+            break;
+        case RadixType::Node48: {
+            const RadixNode48* inner = static_cast<const RadixNode48*>(node);
+            std::size_t b = 0;
+            while (inner->slot[b] == 0) ++b;
+            node = inner->children[inner->slot[b] - 1];
+            break;
+        }
+        default: {
+            const RadixNode256* inner = static_cast<const RadixNode256*>(node);
+            std::size_t b = 0;
+            while (inner->children[b] == nullptr) ++b;
+            node = inner->children[b];
+            break;
+        }
+        }
+    }
+    return static_cast<const RadixLeaf*>(node);
+}
+
+// Number of prefix bytes of node that key matches from depth on, the full prefix length when it matches all of them.
+std::size_t RadixIndex::prefixMismatch(const RadixNode* node, std::string_view key, std::size_t depth) const {
+    std::size_t stored = std::min<std::size_t>(node->prefixLength, RadixNode::MAX_PREFIX);
+    for (std::size_t i = 0; i < stored; ++i) {
+        if (node->prefix[i] != byteAt(key, depth + i)) return i;
+    }
+    if (node->prefixLength > RadixNode::MAX_PREFIX) { // the rest of the prefix is only in the keys below
+        std::string_view full = keyOf(minimumLeaf(node));
+        for (std::size_t i = stored; i < node->prefixLength; ++i) {
+            if (byteAt(full, depth + i) != byteAt(key, depth + i)) return i;
+        }
+    }
+    return node->prefixLength;
+}
+
+// Slot holding node's child for byte, nullptr when there is none.
+RadixNode** RadixIndex::childSlot(RadixNode* node, std::uint8_t byte) {
+    switch (node->type) {
+    case RadixType::Node4: {
+        RadixNode4* inner = static_cast<RadixNode4*>(node);
+        for (std::size_t i = 0; i < inner->childCount; ++i) {
+            if (inner->keys[i] == byte) return &inner->children[i];
+        }
+        return nullptr;
+    }
+    case RadixType::Node16: {
+        RadixNode16* inner = static_cast<RadixNode16*>(node);
+#ifdef RADIX_SSE2
+        // compare all 16 keys at once, then ignore the unused ones
+        __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(inner->keys)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << inner->childCount) - 1);
+        return mask != 0 ? &inner->children[lowestBit(mask)] : nullptr;
+#else
+        for (std::size_t i = 0; i < inner->childCount; ++i) {
+            if (inner->keys[i] == byte) return &inner->children[i];
+        }
+        return nullptr;
+#endif
+    }
+    case RadixType::Node48: {
+        RadixNode48* inner = static_cast<RadixNode48*>(node);
+        return inner->slot[byte] != 0 ? &inner->children[inner->slot[byte] - 1] : nullptr;
+    }
+    case RadixType::Node256: {
+        RadixNode256* inner = static_cast<RadixNode256*>(node);
+        return inner->children[byte] != nullptr ? &inner->children[byte] : nullptr;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+// Add a child under a byte the node doesn't have yet, moving the node up a size when it is full.
+void RadixIndex::addChild(RadixNode** ref, std::uint8_t byte, RadixNode* child) {
+    RadixNode* node = *ref;
+    switch (node->type) {
+    case RadixType::Node4: {
+        RadixNode4* inner = static_cast<RadixNode4*>(node);
+        if (inner->childCount < 4) { // keep the keys sorted for in-order walks
+            std::size_t at = 0;
+            while (at < inner->childCount && inner->keys[at] < byte) ++at;
+            std::memmove(inner->keys + at + 1, inner->keys + at, inner->childCount - at);
+            std::memmove(inner->children + at + 1, inner->children + at, (inner->childCount - at) * sizeof(RadixNode*));
+            inner->keys[at] = byte;
+            inner->children[at] = child;
+            ++inner->childCount;
+            return;
+        }
+        RadixNode16* grown = nodes16.create();
+        grown->type = RadixType::Node16;
+        copyHeader(grown, inner);
+        std::memcpy(grown->keys, inner->keys, 4);
+        std::memcpy(grown->children, inner->children, 4 * sizeof(RadixNode*));
+        nodes4.release(inner);
+        *ref = grown;
+        break;
+    }
+    case RadixType::Node16: {
+        RadixNode16* inner = static_cast<RadixNode16*>(node);
+        if (inner->childCount < 16) {
+            std::size_t at = 0;
+            while (at < inner->childCount && inner->keys[at] < byte) ++at;
+            std::memmove(inner->keys + at + 1, inner->keys + at, inner->childCount - at);
+            std::memmove(inner->children + at + 1, inner->children + at, (inner->childCount - at) * sizeof(RadixNode*));
+            inner->keys[at] = byte;
+            inner->children[at] = child;
+            ++inner->childCount;
+            return;
+        }
+        RadixNode48* grown = nodes48.create();
+        grown->type = RadixType::Node48;
+        copyHeader(grown, inner);
+        for (std::size_t i = 0; i < 16; ++i) {
+            grown->slot[inner->keys[i]] = static_cast<std::uint8_t>(i + 1);
+            grown->children[i] = inner->children[i];
+        }
+        nodes16.release(inner);
+        *ref = grown;
+        break;
+    }
+    case RadixType::Node48: {
+        RadixNode48* inner = static_cast<RadixNode48*>(node);
+        if (inner->childCount < 48) {
+            std::size_t free = 0;
+            while (inner->children[free] != nullptr) ++free; // removals leave holes
+            inner->children[free] = child;
+            inner->slot[byte] = static_cast<std::uint8_t>(free + 1);
+            ++inner->childCount;
+            return;
+        }
+        RadixNode256* grown = nodes256.create();
+        grown->type = RadixType::Node256;
+        copyHeader(grown, inner);
+        for (std::size_t b = 0; b < 256; ++b) {
+            if (inner->slot[b] != 0) grown->children[b] = inner->children[inner->slot[b] - 1];
+        }
+        nodes48.release(inner);
+        *ref = grown;
+        break;
+    }
+    default: {
+        RadixNode256* inner = static_cast<RadixNode256*>(node);
+        inner->children[byte] = child;
+        ++inner->childCount;
+        return;
+    }
+    }
+    addChild(ref, byte, child); // into the grown node, which has room
+}
+
+// Remove the child under byte from the node at depth, moving the node down a size when it gets sparse.
+// A Node4 left with one child is replaced by that child, which takes over the node's prefix and key byte.
+void RadixIndex::removeChild(RadixNode** ref, std::uint8_t byte, std::size_t depth) {
+    RadixNode* node = *ref;
+    switch (node->type) {
+    case RadixType::Node4: {
+        RadixNode4* inner = static_cast<RadixNode4*>(node);
+        std::size_t at = 0;
+        while (inner->keys[at] != byte) ++at;
+        std::memmove(inner->keys + at, inner->keys + at + 1, inner->childCount - at - 1);
+        std::memmove(inner->children + at, inner->children + at + 1, (inner->childCount - at - 1) * sizeof(RadixNode*));
+        if (--inner->childCount > 1) return;
+
+        RadixNode* only = inner->children[0];
+        if (only->type != RadixType::Leaf) { // the prefixes join around the key byte between them
+            only->prefixLength += inner->prefixLength + 1;
+            std::string_view full = keyOf(minimumLeaf(only));
+            std::size_t stored = std::min<std::size_t>(only->prefixLength, RadixNode::MAX_PREFIX);
+            for (std::size_t i = 0; i < stored; ++i) {
+                only->prefix[i] = byteAt(full, depth + i);
+            }
+        }
+        nodes4.release(inner);
+        *ref = only;
+        return;
+    }
+    case RadixType::Node16: {
+        RadixNode16* inner = static_cast<RadixNode16*>(node);
+        std::size_t at = 0;
+        while (inner->keys[at] != byte) ++at;
+        std::memmove(inner->keys + at, inner->keys + at + 1, inner->childCount - at - 1);
+        std::memmove(inner->children + at, inner->children + at + 1, (inner->childCount - at - 1) * sizeof(RadixNode*));
+        if (--inner->childCount > 3) return;
+
+        RadixNode4* shrunk = nodes4.create();
+        shrunk->type = RadixType::Node4;
+        copyHeader(shrunk, inner);
+        std::memcpy(shrunk->keys, inner->keys, inner->childCount);
+        std::memcpy(shrunk->children, inner->children, inner->childCount * sizeof(RadixNode*));
+        nodes16.release(inner);
+        *ref = shrunk;
+        return;
+    }
+    case RadixType::Node48: {
+        RadixNode48* inner = static_cast<RadixNode48*>(node);
+        inner->children[inner->slot[byte] - 1] = nullptr;
+        inner->slot[byte] = 0;
+        if (--inner->childCount > 12) return;
+
+        RadixNode16* shrunk = nodes16.create();
+        shrunk->type = RadixType::Node16;
+        copyHeader(shrunk, inner);
+        std::size_t next = 0;
+        for (std::size_t b = 0; b < 256; ++b) { // in byte order, so the keys come out sorted
+            if (inner->slot[b] == 0) continue;
+            shrunk->keys[next] = static_cast<std::uint8_t>(b);
+            shrunk->children[next] = inner->children[inner->slot[b] - 1];
+            ++next;
+        }
+        nodes48.release(inner);
+        *ref = shrunk;
+        return;
+    }
+    default: {
+        RadixNode256* inner = static_cast<RadixNode256*>(node);
+        inner->children[byte] = nullptr;
+        if (--inner->childCount > 37) return;
+
+        RadixNode48* shrunk = nodes48.create();
+        shrunk->type = RadixType::Node48;
+        copyHeader(shrunk, inner);
+        std::size_t next = 0;
+        for (std::size_t b = 0; b < 256; ++b) {
+            if (inner->children[b] == nullptr) continue;
+            shrunk->children[next] = inner->children[b];
+            shrunk->slot[b] = static_cast<std::uint8_t>(++next);
+        }
+        nodes256.release(inner);
+        *ref = shrunk;
+        return;
+    }
+    }
+}
+
+// Make a leaf for a new key, copying the key into the key text.
+RadixLeaf* RadixIndex::newLeaf(std::string_view key, TreeNode* value) {
+    RadixLeaf* leaf = leaves.create();
+    leaf->type = RadixType::Leaf;
+    leaf->value = value;
+    leaf->keyOffset = static_cast<std::uint32_t>(keyText.size());
+    leaf->keyLength = static_cast<std::uint32_t>(key.size());
+    keyText.append(key.data(), key.size());
+    ++count;
+    return leaf;
+}
+
+// Add a key, or point a key that is already there at value.
+// Returns true when the key was new, false when it was replaced or contains a zero byte.
+bool RadixIndex::insert(std::string_view key, TreeNode* value) {
+    if (key.find('\0') != std::string_view::npos) return false;
+
+    RadixNode** ref = &root;
+    std::size_t depth = 0;
+    while (*ref != nullptr && (*ref)->type != RadixType::Leaf) {
+        RadixNode* node = *ref;
+        std::size_t matched = prefixMismatch(node, key, depth);
+        if (matched < node->prefixLength) {
+            // the key leaves the prefix part way, a Node4 takes the matched part and the node keeps the rest
+            RadixNode4* split = nodes4.create();
+            split->type = RadixType::Node4;
+            split->prefixLength = static_cast<std::uint32_t>(matched);
+            for (std::size_t i = 0; i < std::min<std::size_t>(matched, RadixNode::MAX_PREFIX); ++i) {
+                split->prefix[i] = byteAt(key, depth + i);
+            }
+            std::uint8_t nodeByte;
+            std::size_t rest = node->prefixLength - matched - 1;
+            if (node->prefixLength <= RadixNode::MAX_PREFIX) {
+                nodeByte = node->prefix[matched];
+                std::memmove(node->prefix, node->prefix + matched + 1, rest);
+            }
+            else { // the node doesn't store all of its prefix, read it from a key below
+                std::string_view full = keyOf(minimumLeaf(node));
+                nodeByte = byteAt(full, depth + matched);
+                for (std::size_t i = 0; i < std::min<std::size_t>(rest, RadixNode::MAX_PREFIX); ++i) {
+                    node->prefix[i] = byteAt(full, depth + matched + 1 + i);
+                }
+            }
+            node->prefixLength = static_cast<std::uint32_t>(rest);
+            *ref = split;
+            addChild(ref, nodeByte, node);
+            addChild(ref, byteAt(key, depth + matched), newLeaf(key, value));
+            return true;
+        }
+        depth += node->prefixLength;
+        RadixNode** next = childSlot(node, byteAt(key, depth));
+        if (next == nullptr) { // no child for this byte yet, the leaf goes straight under the node
+            addChild(ref, byteAt(key, depth), newLeaf(key, value));
+            return true;
+        }
+        ref = next;
+        ++depth;
+    }
+
+    if (*ref == nullptr) { // an empty index
+        *ref = newLeaf(key, value);
+        return true;
+    }
+    RadixLeaf* existing = static_cast<RadixLeaf*>(*ref);
+    std::string_view existingKey = keyOf(existing);
+    if (existingKey == key) {
+        existing->value = value;
+        return false;
+    }
+
+    // a leaf is in the way, both go under a Node4 holding the bytes they share
+    std::size_t shared = 0;
+    while (byteAt(key, depth + shared) == byteAt(existingKey, depth + shared)) ++shared; // they differ before both end
+    RadixNode4* split = nodes4.create();
+    split->type = RadixType::Node4;
+    split->prefixLength = static_cast<std::uint32_t>(shared);
+    for (std::size_t i = 0; i < std::min<std::size_t>(shared, RadixNode::MAX_PREFIX); ++i) {
+        split->prefix[i] = byteAt(key, depth + i);
+    }
+    *ref = split;
+    addChild(ref, byteAt(existingKey, depth + shared), existing);
+    addChild(ref, byteAt(key, depth + shared), newLeaf(key, value));
+    return true;
+}
+
+// Remove a key. Returns false when it isn't in the index.
+bool RadixIndex::erase(std::string_view key) {
+    RadixNode** parentRef = nullptr; // slot of the node the leaf hangs under
+    std::size_t parentDepth = 0;
+    std::uint8_t parentByte = 0;
+    RadixNode** ref = &root;
+    std::size_t depth = 0;
+    while (*ref != nullptr) {
+        RadixNode* node = *ref;
+        if (node->type == RadixType::Leaf) {
+            if (keyOf(static_cast<RadixLeaf*>(node)) != key) return false;
+            if (parentRef == nullptr) {
+                root = nullptr;
+            }
+            else {
+                removeChild(parentRef, parentByte, parentDepth);
+            }
+            leaves.release(static_cast<RadixLeaf*>(node));
+            --count;
+            return true;
+        }
+        std::size_t stored = std::min<std::size_t>(node->prefixLength, RadixNode::MAX_PREFIX);
+        for (std::size_t i = 0; i < stored; ++i) {
+            if (node->prefix[i] != byteAt(key, depth + i)) return false;
+        }
+        parentRef = ref;
+        parentDepth = depth;
+        depth += node->prefixLength;
+        parentByte = byteAt(key, depth);
+        ref = childSlot(node, parentByte);
+        if (ref == nullptr) return false;
+        ++depth;
+    }
+    return false;
+}
+
+// Node stored under key. Only the stored prefix bytes are checked on the way down, the leaf's
+// key compare catches a key that differs in the bytes a long prefix skipped.
+TreeNode* RadixIndex::find(std::string_view key) const {
+    RadixNode* node = root;
+    std::size_t depth = 0;
+    while (node != nullptr) {
+        if (node->type == RadixType::Leaf) {
+            const RadixLeaf* leaf = static_cast<const RadixLeaf*>(node);
+            return keyOf(leaf) == key ? leaf->value : nullptr;
+        }
+        std::size_t stored = std::min<std::size_t>(node->prefixLength, RadixNode::MAX_PREFIX);
+        for (std::size_t i = 0; i < stored; ++i) {
+            if (node->prefix[i] != byteAt(key, depth + i)) return nullptr;
+        }
+        depth += node->prefixLength;
+        RadixNode** next = childSlot(node, byteAt(key, depth));
+        node = next != nullptr ? *next : nullptr;
+        ++depth;
+    }
+    return nullptr;
+}
+
+// Remove every key. The arenas free whole slabs, so there is no walk.
+void RadixIndex::clear() {
+    root = nullptr;
+    count = 0;
+    keyText.clear();
+    leaves.clear();
+    nodes4.clear();
+    nodes16.clear();
+    nodes48.clear();
+    nodes256.clear();
+}
+
+// Bytes held by the nodes and keys in use.
+std::size_t RadixIndex::memoryBytes() const {
+    return leaves.size() * sizeof(RadixLeaf) + nodes4.size() * sizeof(RadixNode4) + nodes16.size() * sizeof(RadixNode16)
+        + nodes48.size() * sizeof(RadixNode48) + nodes256.size() * sizeof(RadixNode256) + keyText.size();
+}
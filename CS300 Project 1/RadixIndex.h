@@ -0,0 +1,149 @@
+//=========================================================================
+// Name        : RadixIndex.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Adaptive radix tree from course numbers to the tree's nodes
+//=========================================================================
+
+#pragma once
+#ifndef RADIXINDEX_H
+#define RADIXINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SlabArena.h"
+
+struct TreeNode;
+
+// what a radix node is, stored in its first byte
+enum class RadixType : std::uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+// header every radix node starts with
+struct RadixNode {
+    static constexpr std::size_t MAX_PREFIX = 8; // prefix bytes kept in the node, the rest are checked at the leaf
+
+    RadixType type;
+    std::uint16_t childCount;
+    std::uint32_t prefixLength;        // bytes every key below shares, skipped on the way down
+    std::uint8_t prefix[MAX_PREFIX];   // the first of those bytes
+};
+
+// one key, its bytes are in the index's key text
+struct RadixLeaf : RadixNode {
+    TreeNode* value;
+    std::uint32_t keyOffset;
+    std::uint32_t keyLength;
+};
+
+// up to 4 children, keys sorted
+struct RadixNode4 : RadixNode {
+    std::uint8_t keys[4];
+    RadixNode* children[4];
+};
+
+// up to 16 children, keys sorted and compared 16 at a time
+struct RadixNode16 : RadixNode {
+    std::uint8_t keys[16];
+    RadixNode* children[16];
+};
+
+// up to 48 children, slot[byte] is one more than the child's index, 0 when there is none
+struct RadixNode48 : RadixNode {
+    std::uint8_t slot[256];
+    RadixNode* children[48];
+};
+
+// one child per byte
+struct RadixNode256 : RadixNode {
+    RadixNode* children[256];
+};
+
+// RadixIndex finds a course's node from its uppercase number in one step per key byte,
+// with no string compares on the way down. Inner nodes grow from 4 to 16, 48 and 256
+// children as keys are added and shrink back as they are removed, and a run of bytes
+// that every key below a node shares is stored once in the node and skipped, so
+// "CSCI" costs one step, not four. Only the leaf compares the whole key.
+// A key ends with an implied zero byte, so a number can be a prefix of another; keys
+// can't contain a zero byte themselves, insert() refuses them. Nodes come from slab
+// arenas per size and the key bytes from one text block, removed keys stay in it
+// until clear().
+class RadixIndex {
+private:
+    RadixNode* root;
+    std::size_t count;
+    std::string keyText; // every leaf's key, back to back
+    SlabArena<RadixLeaf> leaves;
+    SlabArena<RadixNode4> nodes4;
+    SlabArena<RadixNode16> nodes16;
+    SlabArena<RadixNode48> nodes48;
+    SlabArena<RadixNode256> nodes256;
+
+    std::string_view keyOf(const RadixLeaf* leaf) const { return std::string_view(keyText.data() + leaf->keyOffset, leaf->keyLength); }
+    const RadixLeaf* minimumLeaf(const RadixNode* node) const;
+    std::size_t prefixMismatch(const RadixNode* node, std::string_view key, std::size_t depth) const;
+    static RadixNode** childSlot(RadixNode* node, std::uint8_t byte);
+    void addChild(RadixNode** ref, std::uint8_t byte, RadixNode* child);
+    void removeChild(RadixNode** ref, std::uint8_t byte, std::size_t depth);
+    RadixLeaf* newLeaf(std::string_view key, TreeNode* value);
+
+public:
+    RadixIndex();
+
+    // the nodes point into the index's own arenas, so it can't be copied
+    RadixIndex(const RadixIndex&) = delete;
+    RadixIndex& operator=(const RadixIndex&) = delete;
+
+    bool insert(std::string_view key, TreeNode* value); // false when the key was there already, its value is replaced
+    bool erase(std::string_view key);
+    TreeNode* find(std::string_view key) const; // nullptr when not found
+    void clear();
+
+    std::size_t size() const { return count; }
+    std::size_t memoryBytes() const;
+
+    // visit every value in key order, without recursion
+    template <typename Visitor>
+    void forEachInOrder(Visitor visit) const {
+        std::vector<const RadixNode*> pending; // nodes still to visit, the next one on top
+        if (root != nullptr) pending.push_back(root);
+        while (!pending.empty()) {
+            const RadixNode* node = pending.back();
+            pending.pop_back();
+            switch (node->type) {
+            case RadixType::Leaf:
+                visit(static_cast<const RadixLeaf*>(node)->value);
+                break;
+            case RadixType::Node4: { // push the children last to first, so the first comes off next
+                const RadixNode4* inner = static_cast<const RadixNode4*>(node);
+                for (std::size_t i = inner->childCount; i-- > 0;) pending.push_back(inner->children[i]);
+                break;
+            }
+            case RadixType::Node16: {
+                const RadixNode16* inner = static_cast<const RadixNode16*>(node);
+                for (std::size_t i = inner->childCount; i-- > 0;) pending.push_back(inner->children[i]);
+                break;
+            }
+            case RadixType::Node48: {
+                const RadixNode48* inner = static_cast<const RadixNode48*>(node);
+                for (std::size_t b = 256; b-- > 0;) {
+                    if (inner->slot[b] != 0) pending.push_back(inner->children[inner->slot[b] - 1]);
+                }
+                break;
+            }
+            case RadixType::Node256: {
+                const RadixNode256* inner = static_cast<const RadixNode256*>(node);
+                for (std::size_t b = 256; b-- > 0;) {
+                    if (inner->children[b] != nullptr) pending.push_back(inner->children[b]);
+                }
+                break;
+            }
+            }
+        }
+    }
+};
+
+#endif // RADIXINDEX_H
@@ -0,0 +1,223 @@
+//=========================================================================
+// Name        : SemesterPlanner.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Plans the terms a student needs to reach a set of target courses
+//=========================================================================
+
+#include "SemesterPlanner.h"
+#include "CaseFold.h"
+
+#include <algorithm> // For std::max, std::sort and the heap functions
+#include <atomic>    // For handing out requests to the batch threads
+#include <thread>    // For planning batches on every core
+
+// what a vertex reached from the targets is to the student
+static const std::uint8_t NEEDED = 1;  // still to take
+static const std::uint8_t DONE = 2;    // completed, or needed by a completed course
+static const std::uint8_t BLOCKED = 3; // needed but can never be taken
+
+// Turn course numbers into vertices, keeping the ones the graph doesn't know.
+void SemesterPlanner::resolve(const std::vector<std::string>& numbers, std::vector<std::uint32_t>& vertices,
+    std::vector<std::string>& unknown) const {
+    for (const std::string& number : numbers) {
+        if (number.empty()) continue;
+        std::size_t vertex = graph.idOf(FoldedKey(number).view());
+        if (vertex == PrerequisiteGraph::NOT_FOUND) {
+            unknown.push_back(number);
+        }
+        else {
+            vertices.push_back(static_cast<std::uint32_t>(vertex));
+        }
+    }
+}
+
+// Plan one student with the given scratch space, which is left clean for the next student.
+SemesterPlan SemesterPlanner::plan(const PlanRequest& request, Workspace& workspace) const {
+    SemesterPlan result;
+    result.lowerBound = 0;
+    std::size_t n = graph.size();
+    if (workspace.state.size() != n) {
+        workspace.seen.assign((n + 63) / 64, 0);
+        workspace.state.assign(n, 0);
+        workspace.remaining.assign(n, 0);
+        workspace.height.assign(n, 0);
+    }
+    std::vector<std::uint64_t>& seen = workspace.seen;
+    std::vector<std::uint8_t>& state = workspace.state;
+    std::vector<std::uint32_t>& remaining = workspace.remaining;
+    std::vector<std::uint32_t>& height = workspace.height;
+    std::vector<std::uint32_t>& needed = workspace.needed;
+    std::vector<std::uint32_t>& order = workspace.order;
+    workspace.touched.clear();
+    needed.clear();
+    order.clear();
+
+    // mark a vertex as reached, returns false if it was already
+    auto reach = [&](std::uint32_t v, std::uint8_t as) {
+        std::uint64_t bit = std::uint64_t(1) << (v % 64);
+        if (seen[v / 64] & bit) return false;
+        seen[v / 64] |= bit;
+        state[v] = as;
+        workspace.touched.push_back(v);
+        return true;
+    };
+
+    std::vector<std::uint32_t> completed, targets;
+    resolve(request.completed, completed, result.unknown);
+    resolve(request.targets, targets, result.unknown);
+
+    // a completed course's prerequisites were met as well, all the way down
+    std::vector<std::uint32_t> frontier;
+    for (std::uint32_t v : completed) {
+        if (reach(v, DONE)) frontier.push_back(v);
+    }
+    while (!frontier.empty()) {
+        std::uint32_t v = frontier.back();
+        frontier.pop_back();
+        for (std::size_t i = 0; i < graph.directPrerequisiteCount(v); ++i) {
+            std::uint32_t u = static_cast<std::uint32_t>(graph.directPrerequisite(v, i));
+            if (reach(u, DONE)) frontier.push_back(u);
+        }
+    }
+
+    // walk down from the targets to every prerequisite still to take, stopping at done courses
+    for (std::uint32_t v : targets) {
+        if (reach(v, NEEDED)) frontier.push_back(v);
+    }
+    while (!frontier.empty()) {
+        std::uint32_t v = frontier.back();
+        frontier.pop_back();
+        needed.push_back(v);
+        for (std::size_t i = 0; i < graph.directPrerequisiteCount(v); ++i) {
+            std::uint32_t u = static_cast<std::uint32_t>(graph.directPrerequisite(v, i));
+            if (reach(u, NEEDED)) frontier.push_back(u);
+        }
+    }
+
+    // order the needed courses prerequisites first, anything left over sits on a cycle
+    for (std::uint32_t v : needed) {
+        for (std::size_t i = 0; i < graph.directPrerequisiteCount(v); ++i) {
+            if (state[graph.directPrerequisite(v, i)] == NEEDED) ++remaining[v];
+        }
+        if (remaining[v] == 0) order.push_back(v);
+    }
+    for (std::size_t next = 0; next < order.size(); ++next) {
+        std::uint32_t v = order[next];
+        for (std::size_t i = 0; i < graph.directDependentCount(v); ++i) {
+            std::uint32_t d = static_cast<std::uint32_t>(graph.directDependent(v, i));
+            if (state[d] == NEEDED && --remaining[d] == 0) order.push_back(d);
+        }
+    }
+    for (std::uint32_t v : needed) {
+        if (remaining[v] != 0) {
+            state[v] = BLOCKED;
+            remaining[v] = 0;
+        }
+    }
+
+    // a course not in the catalog can't be taken, and neither can anything after it
+    for (std::uint32_t v : order) {
+        bool blocked = !graph.isInCatalog(v);
+        for (std::size_t i = 0; i < graph.directPrerequisiteCount(v) && !blocked; ++i) {
+            blocked = state[graph.directPrerequisite(v, i)] == BLOCKED;
+        }
+        if (blocked) state[v] = BLOCKED;
+    }
+
+    // heights from the targets down, counting each course's needed prerequisites again for the terms below
+    std::size_t schedulable = 0;
+    std::size_t tallest = 0;
+    for (std::size_t i = order.size(); i-- > 0;) {
+        std::uint32_t v = order[i];
+        if (state[v] != NEEDED) continue;
+        std::uint32_t above = 0;
+        for (std::size_t j = 0; j < graph.directDependentCount(v); ++j) {
+            std::uint32_t d = static_cast<std::uint32_t>(graph.directDependent(v, j));
+            if (state[d] == NEEDED) {
+                above = std::max(above, height[d]);
+                ++remaining[d];
+            }
+        }
+        height[v] = above + 1;
+        tallest = std::max<std::size_t>(tallest, height[v]);
+        ++schedulable;
+    }
+    std::size_t perTerm = std::max<std::size_t>(1, request.perTerm);
+    result.lowerBound = std::max(tallest, (schedulable + perTerm - 1) / perTerm);
+
+    // fill the terms from the courses that are ready, tallest first, ties in course order
+    auto later = [&height](std::uint32_t a, std::uint32_t b) {
+        return height[a] != height[b] ? height[a] < height[b] : a > b;
+    };
+    std::vector<std::uint32_t> ready;
+    for (std::uint32_t v : order) {
+        if (state[v] == NEEDED && remaining[v] == 0) ready.push_back(v);
+    }
+    std::make_heap(ready.begin(), ready.end(), later);
+    while (!ready.empty()) {
+        std::vector<std::uint32_t> term;
+        while (!ready.empty() && term.size() < perTerm) {
+            std::pop_heap(ready.begin(), ready.end(), later);
+            term.push_back(ready.back());
+            ready.pop_back();
+        }
+        for (std::uint32_t v : term) { // their dependents can go in the next term at the earliest
+            for (std::size_t i = 0; i < graph.directDependentCount(v); ++i) {
+                std::uint32_t d = static_cast<std::uint32_t>(graph.directDependent(v, i));
+                if (state[d] == NEEDED && --remaining[d] == 0) {
+                    ready.push_back(d);
+                    std::push_heap(ready.begin(), ready.end(), later);
+                }
+            }
+        }
+        std::sort(term.begin(), term.end());
+        result.terms.push_back(std::move(term));
+    }
+
+    for (std::uint32_t v : needed) {
+        if (state[v] == BLOCKED) result.blocked.push_back(v);
+    }
+    std::sort(result.blocked.begin(), result.blocked.end());
+
+    // leave the scratch space clean
+    for (std::uint32_t v : workspace.touched) {
+        seen[v / 64] = 0;
+        state[v] = 0;
+        remaining[v] = 0;
+        height[v] = 0;
+    }
+    return result;
+}
+
+// Plan one student with scratch space of its own.
+SemesterPlan SemesterPlanner::plan(const PlanRequest& request) const {
+    Workspace workspace;
+    return plan(request, workspace);
+}
+
+// Plan every request, each thread takes the next unplanned one and keeps its own scratch space.
+// The graph is only read, so the threads share it without locks.
+std::vector<SemesterPlan> SemesterPlanner::planAll(const std::vector<PlanRequest>& requests, std::size_t threads) const {
+    std::vector<SemesterPlan> plans(requests.size());
+    if (threads == 0) {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = std::max<std::size_t>(1, std::min(threads, requests.size()));
+
+    std::atomic<std::size_t> next(0);
+    auto work = [&]() {
+        Workspace workspace;
+        for (std::size_t i = next++; i < requests.size(); i = next++) {
+            plans[i] = plan(requests[i], workspace);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) worker.join();
+    return plans;
+}
@@ -0,0 +1,73 @@
+//=========================================================================
+// Name        : SemesterPlanner.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Plans the terms a student needs to reach a set of target courses
+//=========================================================================
+
+#pragma once
+#ifndef SEMESTERPLANNER_H
+#define SEMESTERPLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PrerequisiteGraph.h"
+
+// what one student asks for
+struct PlanRequest {
+    std::vector<std::string> completed; // courses already passed, their own prerequisites count as done
+    std::vector<std::string> targets;   // courses the student wants to have taken
+    std::size_t perTerm;                // most courses in one term
+};
+
+// the terms planned for one student, courses are graph vertices
+struct SemesterPlan {
+    std::vector<std::vector<std::uint32_t>> terms;
+    std::size_t lowerBound;              // no plan can use fewer terms than this
+    std::vector<std::uint32_t> blocked;  // needed but impossible: not in the catalog, on a cycle, or after one of those
+    std::vector<std::string> unknown;    // requested numbers the catalog doesn't know
+
+    bool isShortest() const { return terms.size() == lowerBound; }
+};
+
+// SemesterPlanner lays the courses a student still needs into terms.
+// The needed courses are the targets and everything they need, up to the completed courses.
+// They are found by walking the graph's CSR edges from the targets, with a bitset of the
+// courses seen, so only the student's part of the catalog is touched. Each course gets its
+// height, the longest chain of needed courses resting on it. Terms are then filled from the
+// courses whose prerequisites are all done, tallest first, so the long chains start early.
+// A shortest plan under a per-term cap is NP-hard in general. This order is optimal when
+// prerequisites form trees, and lowerBound (the longest chain, or the course count over the
+// cap) tells when a plan is known to be shortest.
+class SemesterPlanner {
+public:
+    // scratch arrays for one thread, sized to the graph once and reset through touched
+    struct Workspace {
+        std::vector<std::uint64_t> seen;       // bitset of vertices reached from the targets
+        std::vector<std::uint8_t> state;       // NEEDED, DONE or untouched per vertex
+        std::vector<std::uint32_t> remaining;  // needed prerequisites not yet placed in a term
+        std::vector<std::uint32_t> height;     // longest chain of needed courses from the vertex up to a target
+        std::vector<std::uint32_t> touched;    // vertices whose entries have to be reset
+        std::vector<std::uint32_t> needed;
+        std::vector<std::uint32_t> order;      // needed vertices, prerequisites first
+    };
+
+private:
+    const PrerequisiteGraph& graph;
+
+    void resolve(const std::vector<std::string>& numbers, std::vector<std::uint32_t>& vertices, std::vector<std::string>& unknown) const;
+
+public:
+    explicit SemesterPlanner(const PrerequisiteGraph& prerequisites) : graph(prerequisites) {}
+
+    SemesterPlan plan(const PlanRequest& request, Workspace& workspace) const;
+    SemesterPlan plan(const PlanRequest& request) const;
+
+    // plan every request, spread over the cores, results in request order
+    std::vector<SemesterPlan> planAll(const std::vector<PlanRequest>& requests, std::size_t threads = 0) const;
+};
+
+#endif // SEMESTERPLANNER_H
@@ -0,0 +1,105 @@
+//=========================================================================
+// Name        : SharedCatalog.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Publishes read-only catalog versions to many reader threads
+//=========================================================================
+
+#include "SharedCatalog.h"
+
+#include <algorithm> // For std::min and std::remove_if
+#include <limits>    // For std::numeric_limits
+
+// Constructor. Epochs start at 1, a slot holding 0 is not pinned.
+SharedCatalog::SharedCatalog() : current(nullptr), globalEpoch(1), slots(nullptr), freedCount(0) {}
+
+// Destructor. No reader can be left, so every version and slot is freed.
+SharedCatalog::~SharedCatalog() {
+    delete current.load();
+    for (const Retired& version : retired) {
+        delete version.tree;
+    }
+    ReaderSlot* slot = slots.load();
+    while (slot != nullptr) {
+        ReaderSlot* next = slot->next;
+        delete slot;
+        slot = next;
+    }
+}
+
+// Find a free reader slot or add one. Slots are pushed onto the list with a compare-and-swap
+// and never unlinked, so walking the list needs no lock.
+SharedCatalog::ReaderSlot* SharedCatalog::claimSlot() {
+    for (ReaderSlot* slot = slots.load(); slot != nullptr; slot = slot->next) {
+        bool expected = false;
+        if (slot->claimed.compare_exchange_strong(expected, true)) {
+            return slot;
+        }
+    }
+    ReaderSlot* slot = new ReaderSlot(); // starts claimed
+    ReaderSlot* head = slots.load();
+    do {
+        slot->next = head;
+    } while (!slots.compare_exchange_weak(head, slot));
+    return slot;
+}
+
+// Pin the current epoch, then load the current version.
+// Both are sequentially consistent: a publisher that finds the slot unpinned swapped its
+// version in before the load below, so the version it retires is never the one returned.
+SharedCatalog::ReadGuard SharedCatalog::Reader::read() {
+    slot->epoch.store(catalog.globalEpoch.load());
+    return ReadGuard(slot, catalog.current.load());
+}
+
+// Make tree the version new reads see. The tree must not be changed after this,
+// the catalog owns it and frees it once it has been replaced and no reader holds it.
+void SharedCatalog::publish(std::unique_ptr<BinarySearchTree> tree) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    const BinarySearchTree* old = current.exchange(tree.release());
+    if (old != nullptr) {
+        retired.push_back({ old, globalEpoch.load() }); // readers pinned at this epoch or earlier may hold it
+    }
+    globalEpoch.fetch_add(1); // readers pinning from now on only see the new version
+    reclaimLocked();
+}
+
+// Free the retired versions replaced before the oldest epoch any reader has pinned.
+std::size_t SharedCatalog::reclaimLocked() {
+    std::uint64_t oldestPinned = std::numeric_limits<std::uint64_t>::max();
+    for (ReaderSlot* slot = slots.load(); slot != nullptr; slot = slot->next) {
+        std::uint64_t epoch = slot->epoch.load();
+        if (epoch != 0) {
+            oldestPinned = std::min(oldestPinned, epoch);
+        }
+    }
+
+    std::size_t freed = 0;
+    retired.erase(std::remove_if(retired.begin(), retired.end(), [&](const Retired& version) {
+        if (version.epoch >= oldestPinned) return false;
+        delete version.tree;
+        ++freed;
+        return true;
+    }), retired.end());
+    freedCount += freed;
+    return freed;
+}
+
+// Free what the readers have let go of since the last publish.
+std::size_t SharedCatalog::reclaim() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    return reclaimLocked();
+}
+
+// Number of replaced versions still waiting for their readers.
+std::size_t SharedCatalog::retiredCount() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    return retired.size();
+}
+
+// Number of replaced versions freed so far.
+std::size_t SharedCatalog::freedTotal() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    return freedCount;
+}
@@ -0,0 +1,115 @@
+//=========================================================================
+// Name        : SharedCatalog.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Publishes read-only catalog versions to many reader threads
+//=========================================================================
+
+#pragma once
+#ifndef SHAREDCATALOG_H
+#define SHAREDCATALOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "BinarySearchTree.h"
+
+// SharedCatalog lets reader threads look courses up while another thread loads a new version.
+// A published tree is never changed again. Readers pin the current epoch in their own slot and
+// load the current version, with no lock and no write anyone else reads. A reload builds a whole
+// new tree off to the side and swaps it in with one atomic exchange, so a reader sees the old
+// version or the new one, never a mix. The old version is retired with the epoch it was replaced
+// in and freed once every pinned reader started after that epoch.
+//
+// Each reader thread registers a Reader once and calls read() per lookup:
+//     SharedCatalog::Reader reader(catalog);
+//     SharedCatalog::ReadGuard courses = reader.read();
+//     CourseIterator course = courses->find("CSCI300");
+// The guard keeps its version alive, so iterators from it stay valid until it is dropped.
+class SharedCatalog {
+private:
+    // one reader thread's pinned epoch, on its own cache line so readers don't slow each other down
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch; // 0 when the reader holds no version
+        std::atomic<bool> claimed;        // a Reader owns the slot
+        ReaderSlot* next;                 // slots are only ever added, until the catalog is destroyed
+
+        ReaderSlot() : epoch(0), claimed(true), next(nullptr) {}
+    };
+
+    // a replaced version waiting for its readers to finish
+    struct Retired {
+        const BinarySearchTree* tree;
+        std::uint64_t epoch; // the epoch it was replaced in
+    };
+
+    std::atomic<const BinarySearchTree*> current;
+    std::atomic<std::uint64_t> globalEpoch;
+    std::atomic<ReaderSlot*> slots;
+    std::mutex writerMutex; // publishers take turns, readers never touch it
+    std::vector<Retired> retired;
+    std::size_t freedCount;
+
+    ReaderSlot* claimSlot();
+    std::size_t reclaimLocked();
+
+public:
+    // keeps one version alive while a reader uses it
+    class ReadGuard {
+    private:
+        friend class SharedCatalog;
+
+        ReaderSlot* slot;
+        const BinarySearchTree* tree;
+
+        ReadGuard(ReaderSlot* readerSlot, const BinarySearchTree* version) : slot(readerSlot), tree(version) {}
+
+    public:
+        ReadGuard(ReadGuard&& other) noexcept : slot(other.slot), tree(other.tree) { other.slot = nullptr; }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+        ~ReadGuard() {
+            if (slot != nullptr) slot->epoch.store(0, std::memory_order_release); // unpin
+        }
+
+        // null until the first version is published
+        const BinarySearchTree* get() const { return tree; }
+        const BinarySearchTree& operator*() const { return *tree; }
+        const BinarySearchTree* operator->() const { return tree; }
+        explicit operator bool() const { return tree != nullptr; }
+    };
+
+    // one reader thread's registration, a thread holds one guard from it at a time
+    class Reader {
+    private:
+        SharedCatalog& catalog;
+        ReaderSlot* slot;
+
+    public:
+        explicit Reader(SharedCatalog& shared) : catalog(shared), slot(shared.claimSlot()) {}
+        ~Reader() { slot->claimed.store(false, std::memory_order_release); } // the next Reader may reuse the slot
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        ReadGuard read();
+    };
+
+    SharedCatalog(); // constructor
+    ~SharedCatalog(); // destructor, every Reader must be gone by now
+
+    SharedCatalog(const SharedCatalog&) = delete;
+    SharedCatalog& operator=(const SharedCatalog&) = delete;
+
+    void publish(std::unique_ptr<BinarySearchTree> tree);
+    std::size_t reclaim(); // free the retired versions no reader can still hold, returns how many were freed
+
+    std::size_t retiredCount(); // versions replaced but not yet freed
+    std::size_t freedTotal();   // versions freed so far
+};
+
+#endif // SHAREDCATALOG_H
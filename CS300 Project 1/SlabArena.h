@@ -0,0 +1,112 @@
+//=========================================================================
+// Name        : SlabArena.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Slab arena that hands out tree nodes from contiguous blocks
+//=========================================================================
+
+#pragma once
+#ifndef SLABARENA_H
+#define SLABARENA_H
+
+#include <cstddef>
+#include <new>         // For placement new and ::operator new
+#include <type_traits> // For std::is_trivially_destructible
+#include <utility>     // For std::forward and std::swap
+#include <vector>
+
+// SlabArena carves objects out of large slabs instead of one heap allocation each.
+// Objects made one after another land next to each other in memory, and clear()
+// releases everything slab by slab without walking whatever structure links them.
+// An arena made with one object per slab allocates every object on its own, the way
+// plain new would, which is what --bench-arena compares against.
+template <typename T>
+class SlabArena {
+public:
+    static constexpr std::size_t DEFAULT_SLAB_ITEMS = 1024; // objects per slab
+
+private:
+
+    // a released slot holds the link to the next released one
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    std::vector<T*> slabs; // raw storage, each block holds slabItems objects
+    std::size_t slabItems;  // objects per slab
+    std::size_t usedInLast; // objects constructed in the last slab
+    std::size_t count;      // objects alive in total
+    FreeSlot* freeSlots;    // released slots, reused before the last slab grows
+
+public:
+    explicit SlabArena(std::size_t itemsPerSlab = DEFAULT_SLAB_ITEMS)
+        : slabItems(itemsPerSlab > 0 ? itemsPerSlab : 1), usedInLast(slabItems), count(0), freeSlots(nullptr) {}
+    ~SlabArena() { clear(); }
+
+    // the arena owns its slabs, so it can't be copied
+    SlabArena(const SlabArena&) = delete;
+    SlabArena& operator=(const SlabArena&) = delete;
+
+    // Construct a new object in the next free slot, starting a new slab when the last one is full.
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (freeSlots != nullptr) { // reuse a released slot first
+            FreeSlot* next = freeSlots->next;
+            T* slot = new (static_cast<void*>(freeSlots)) T(std::forward<Args>(args)...);
+            freeSlots = next;
+            ++count;
+            return slot;
+        }
+        if (usedInLast == slabItems) {
+            slabs.push_back(static_cast<T*>(::operator new(sizeof(T) * slabItems)));
+            usedInLast = 0;
+        }
+        T* slot = slabs.back() + usedInLast;
+        new (slot) T(std::forward<Args>(args)...); // only count the slot once construction succeeded
+        ++usedInLast;
+        ++count;
+        return slot;
+    }
+
+    // Hand one object's slot back for the next create(). Only for trivially destructible
+    // types, so clear() never has to know which slots were released.
+    void release(T* item) {
+        static_assert(std::is_trivially_destructible<T>::value, "release needs a trivially destructible type");
+        static_assert(sizeof(T) >= sizeof(FreeSlot) && alignof(T) >= alignof(FreeSlot), "a released slot must fit the free list link");
+        freeSlots = new (static_cast<void*>(item)) FreeSlot{ freeSlots };
+        --count;
+    }
+
+    // Destroy every object and release the slabs. Objects are destroyed in
+    // allocation order, and the loop disappears entirely for trivially destructible types.
+    void clear() {
+        for (std::size_t s = 0; s < slabs.size(); ++s) {
+            if (!std::is_trivially_destructible<T>::value) {
+                std::size_t used = (s + 1 == slabs.size()) ? usedInLast : slabItems;
+                for (std::size_t i = 0; i < used; ++i) {
+                    slabs[s][i].~T();
+                }
+            }
+            ::operator delete(slabs[s]);
+        }
+        slabs.clear();
+        usedInLast = slabItems;
+        count = 0;
+        freeSlots = nullptr;
+    }
+
+    // Exchange contents with another arena.
+    void swap(SlabArena& other) {
+        slabs.swap(other.slabs);
+        std::swap(slabItems, other.slabItems);
+        std::swap(usedInLast, other.usedInLast);
+        std::swap(count, other.count);
+        std::swap(freeSlots, other.freeSlots);
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t itemsPerSlab() const { return slabItems; }
+};
+
+#endif // SLABARENA_H
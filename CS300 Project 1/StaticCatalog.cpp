@@ -0,0 +1,178 @@
+//=========================================================================
+// Name        : StaticCatalog.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Read-only catalog compiled into the program, found through a perfect hash
+//=========================================================================
+
+#include "StaticCatalog.h"
+#include "BinarySearchTree.h"
+
+#include <algorithm> // For std::stable_sort and std::lower_bound
+#include <cctype>    // For building the include guard
+#include <fstream>   // For writing the header
+#include <vector>
+
+// course keys per bucket on average, fewer makes the seeds quicker to find and the seed array longer
+static const std::size_t KEYS_PER_BUCKET = 3;
+static const std::uint32_t MAX_SEED = 1u << 24; // a bucket that finds no seed by then fails the build
+static const std::size_t MAX_CHECKED_COURSES = 4096; // bigger catalogs skip the static_assert, it would hit the compiler's constexpr limits
+
+// Quote bytes as a C++ string literal. Anything but printable ASCII is written as a three digit octal
+// escape, which can't run into the next character the way a hex escape can.
+static std::string cppLiteral(std::string_view text) {
+    static const char OCTAL[] = "01234567";
+    std::string literal = "\"";
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            literal += '\\';
+            literal += c;
+        }
+        else if (byte < 0x20 || byte >= 0x7F) {
+            literal += '\\';
+            literal += OCTAL[byte >> 6];
+            literal += OCTAL[(byte >> 3) & 7];
+            literal += OCTAL[byte & 7];
+        }
+        else {
+            literal += c;
+        }
+    }
+    literal += "\"sv"; // the literal carries its length, so the compiler doesn't count the bytes of every string
+    return literal;
+}
+
+// Find a seed for every bucket so the catalog's numbers fill the slots one each. Buckets are placed
+// largest first, while most slots are still free. Returns false if a bucket runs out of seeds.
+static bool findPerfectHash(const std::vector<std::string>& numbers, std::vector<std::uint32_t>& seeds, std::vector<std::uint32_t>& slots) {
+    std::size_t n = numbers.size();
+    std::size_t bucketCount = (n + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+    std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+    for (std::size_t i = 0; i < n; ++i) {
+        buckets[StaticCatalog::hashOf(numbers[i], 0) % bucketCount].push_back(static_cast<std::uint32_t>(i));
+    }
+    std::vector<std::uint32_t> order(bucketCount);
+    for (std::size_t b = 0; b < bucketCount; ++b) order[b] = static_cast<std::uint32_t>(b);
+    std::stable_sort(order.begin(), order.end(), [&buckets](std::uint32_t a, std::uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    seeds.assign(bucketCount, 0);
+    slots.assign(n, StaticCatalog::NOT_FOUND);
+    std::vector<std::size_t> tried; // slots the current seed sends the bucket's numbers to
+    for (std::uint32_t b : order) {
+        const std::vector<std::uint32_t>& bucket = buckets[b];
+        if (bucket.empty()) break; // only empty buckets are left, their seed is never read for a catalog number
+        std::uint32_t seed = 1;
+        for (; seed < MAX_SEED; ++seed) {
+            tried.clear();
+            bool fits = true;
+            for (std::uint32_t course : bucket) {
+                std::size_t slot = StaticCatalog::hashOf(numbers[course], seed) % n;
+                if (slots[slot] != StaticCatalog::NOT_FOUND || std::find(tried.begin(), tried.end(), slot) != tried.end()) {
+                    fits = false;
+                    break;
+                }
+                tried.push_back(slot);
+            }
+            if (fits) break;
+        }
+        if (seed == MAX_SEED) return false;
+        seeds[b] = seed;
+        for (std::size_t i = 0; i < bucket.size(); ++i) {
+            slots[tried[i]] = bucket[i];
+        }
+    }
+    return true;
+}
+
+// Write the catalog as a header of constexpr arrays and the StaticCatalog over them, named
+// namespaceName::CATALOG. Prerequisites are resolved to course indices here, once.
+bool WriteStaticCatalog(const BinarySearchTree& bst, const std::string& source, const std::string& headerPath, const std::string& namespaceName) {
+    // copy the courses out in sorted order, the arrays keep that order
+    std::vector<std::string> numbers;
+    std::vector<std::string> titles;
+    std::vector<std::uint32_t> prereqFirst;
+    std::vector<std::string> prereqNumbers;
+    bst.forEachCursor([&](const CourseCursor& course) {
+        numbers.emplace_back(course.number());
+        titles.emplace_back(course.title());
+        prereqFirst.push_back(static_cast<std::uint32_t>(prereqNumbers.size()));
+        for (std::size_t i = 0; i < course.prerequisiteCount(); ++i) {
+            prereqNumbers.emplace_back(course.prerequisite(i));
+        }
+    });
+    prereqFirst.push_back(static_cast<std::uint32_t>(prereqNumbers.size()));
+    if (numbers.empty()) return false;
+
+    std::vector<std::uint32_t> seeds, slots;
+    if (!findPerfectHash(numbers, seeds, slots)) return false;
+
+    std::ofstream header(headerPath, std::ios::binary);
+    if (!header) return false;
+
+    // the header's include guard, from its file name
+    std::string fileName = headerPath.substr(headerPath.find_last_of("/\\") + 1);
+    std::string guard;
+    for (char c : fileName) {
+        guard += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+    }
+    std::string sourceName = source.substr(source.find_last_of("/\\") + 1);
+
+    header << "//=========================================================================\n"
+        << "// Name        : " << fileName << "\n"
+        << "// Author      : John St Hilaire\n"
+        << "// Version     : 1.0\n"
+        << "// Description : Catalog compiled from " << sourceName << ", generated by --generate-catalog, do not edit\n"
+        << "//=========================================================================\n\n"
+        << "#pragma once\n#ifndef " << guard << "\n#define " << guard << "\n\n"
+        << "#include <cstdint>\n#include <string_view>\n#include \"StaticCatalog.h\"\n\n"
+        << "namespace " << namespaceName << " {\n\n"
+        << "using namespace std::string_view_literals;\n\n";
+
+    header << "// " << numbers.size() << " courses in sorted order\n"
+        << "inline constexpr StaticCourse COURSES[] = {\n";
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        header << "    { " << cppLiteral(numbers[i]) << ", " << cppLiteral(titles[i]) << ", " << prereqFirst[i] << ", "
+            << prereqFirst[i + 1] - prereqFirst[i] << " },\n";
+    }
+    header << "};\n\n";
+
+    header << "// prerequisites resolved to their course, the number alone when the catalog doesn't list it\n"
+        << "inline constexpr StaticPrerequisite PREREQUISITES[] = {\n";
+    for (const std::string& prerequisite : prereqNumbers) {
+        auto it = std::lower_bound(numbers.begin(), numbers.end(), prerequisite);
+        header << "    { ";
+        if (it != numbers.end() && *it == prerequisite) {
+            header << (it - numbers.begin());
+        }
+        else {
+            header << "StaticCatalog::NOT_FOUND";
+        }
+        header << ", " << cppLiteral(prerequisite) << " },\n";
+    }
+    if (prereqNumbers.empty()) {
+        header << "    { StaticCatalog::NOT_FOUND, \"\"sv }, // no course has prerequisites, an array can't be empty\n";
+    }
+    header << "};\n\n";
+
+    // the hash arrays, several numbers to a line
+    auto writeNumbers = [&header](const std::vector<std::uint32_t>& values) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            header << (i % 12 == 0 ? "    " : " ") << values[i] << ",";
+            if (i % 12 == 11 || i + 1 == values.size()) header << "\n";
+        }
+    };
+    header << "// perfect hash: a number's bucket seed sends it to its slot, the slot holds its course\n"
+        << "inline constexpr std::uint32_t SEEDS[] = {\n";
+    writeNumbers(seeds);
+    header << "};\n\ninline constexpr std::uint32_t SLOTS[] = {\n";
+    writeNumbers(slots);
+    header << "};\n\n"
+        << "inline constexpr StaticCatalog CATALOG(COURSES, PREREQUISITES, SEEDS, SLOTS);\n";
+    if (numbers.size() <= MAX_CHECKED_COURSES) {
+        header << "static_assert(CATALOG.findsEveryCourse(), \"the perfect hash must find every course\");\n";
+    }
+    header << "\n} // namespace " << namespaceName << "\n\n#endif // " << guard << "\n";
+    return static_cast<bool>(header.flush());
+}
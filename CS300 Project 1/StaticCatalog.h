@@ -0,0 +1,111 @@
+//=========================================================================
+// Name        : StaticCatalog.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Read-only catalog compiled into the program, found through a perfect hash
+//=========================================================================
+
+#pragma once
+#ifndef STATICCATALOG_H
+#define STATICCATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class BinarySearchTree;
+
+// one course of a compiled catalog, the courses are in sorted order
+struct StaticCourse {
+    std::string_view number;
+    std::string_view title;
+    std::uint32_t prereqFirst; // first entry in the prerequisites array
+    std::uint32_t prereqCount;
+};
+
+// a prerequisite resolved to its course, or NOT_FOUND when the catalog doesn't list it
+struct StaticPrerequisite {
+    std::uint32_t course;
+    std::string_view number;
+};
+
+// StaticCatalog reads a catalog that was turned into constexpr arrays at build time by
+// WriteStaticCatalog, so there is nothing to load, allocate or follow at run time.
+// Lookups use a minimal perfect hash built by hash and displace: a number's first hash
+// picks its bucket, and the bucket's seed, chosen by the generator, sends every number
+// in the bucket to its own slot, one slot per course. A lookup is two hashes, two array
+// reads and one compare, and works in constant expressions as well.
+class StaticCatalog {
+public:
+    static constexpr std::uint32_t NOT_FOUND = static_cast<std::uint32_t>(-1);
+
+    // FNV-1a over the bytes, then a multiply-xorshift finish so the low bits mix well
+    static constexpr std::uint64_t hashOf(std::string_view key, std::uint64_t seed) {
+        std::uint64_t hash = 0xCBF29CE484222325ull ^ (seed * 0x9E3779B97F4A7C15ull);
+        for (char c : key) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+        }
+        hash ^= hash >> 32;
+        hash *= 0xD6E8FEB86659FD93ull;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+private:
+    const StaticCourse* courses;
+    std::size_t courseCount;
+    const StaticPrerequisite* prerequisites;
+    const std::uint32_t* seeds; // per bucket
+    std::size_t bucketCount;
+    const std::uint32_t* slots; // slot -> course
+
+public:
+    template <std::size_t COURSES, std::size_t PREREQUISITES, std::size_t BUCKETS>
+    constexpr StaticCatalog(const StaticCourse (&courseArray)[COURSES], const StaticPrerequisite (&prerequisiteArray)[PREREQUISITES],
+        const std::uint32_t (&seedArray)[BUCKETS], const std::uint32_t (&slotArray)[COURSES])
+        : courses(courseArray), courseCount(COURSES), prerequisites(prerequisiteArray), seeds(seedArray), bucketCount(BUCKETS), slots(slotArray) {}
+
+    constexpr std::size_t size() const { return courseCount; }
+    constexpr const StaticCourse& course(std::size_t i) const { return courses[i]; }
+    constexpr const StaticPrerequisite& prerequisite(const StaticCourse& of, std::size_t i) const { return prerequisites[of.prereqFirst + i]; }
+
+    // index of the course with an uppercase number, NOT_FOUND when there is none
+    constexpr std::uint32_t find(std::string_view courseNumber) const {
+        std::uint32_t bucket = static_cast<std::uint32_t>(hashOf(courseNumber, 0) % bucketCount);
+        std::uint32_t candidate = slots[hashOf(courseNumber, seeds[bucket]) % courseCount];
+        return courses[candidate].number == courseNumber ? candidate : NOT_FOUND; // a number outside the catalog lands somewhere too
+    }
+
+    // index of the first course not before an uppercase number, size() when there is none
+    constexpr std::size_t lowerBound(std::string_view courseNumber) const {
+        std::size_t first = 0;
+        std::size_t count = courseCount;
+        while (count > 0) {
+            std::size_t half = count / 2;
+            if (courses[first + half].number < courseNumber) {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    // true when every course is found at its own index, for a static_assert in the generated header
+    constexpr bool findsEveryCourse() const {
+        for (std::size_t i = 0; i < courseCount; ++i) {
+            if (find(courses[i].number) != i) return false;
+        }
+        return true;
+    }
+};
+
+// write the loaded catalog out as a header defining namespaceName::CATALOG, returns false if
+// the file can't be written, the catalog is empty or no perfect hash was found
+bool WriteStaticCatalog(const BinarySearchTree& bst, const std::string& source, const std::string& headerPath, const std::string& namespaceName);
+
+#endif // STATICCATALOG_H
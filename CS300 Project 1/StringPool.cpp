@@ -0,0 +1,94 @@
+//=========================================================================
+// Name        : StringPool.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Shared string pool that interns course numbers as dense ids
+//=========================================================================
+
+#include "StringPool.h"
+
+// Pack the first 8 bytes of a course number into an integer whose order matches string order.
+// Shorter numbers are padded with zero bytes, which sort before any real character.
+std::uint64_t StringPool::packKey(std::string_view courseNumber) {
+    std::uint64_t key = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        unsigned char c = i < courseNumber.size() ? static_cast<unsigned char>(courseNumber[i]) : 0;
+        key = (key << 8) | c;
+    }
+    return key;
+}
+
+// FNV-1a over the bytes of the string.
+// source: http://www.isthe.com/chongo/tech/comp/fnv/
+std::uint64_t StringPool::hashOf(std::string_view str) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Find the slot holding str, or the empty slot where it would go. Linear probing.
+// Each entry keeps the top 32 bits of its hash next to the id, they pick the home
+// slot and rule out most other strings without touching the text.
+std::size_t StringPool::slotFor(std::string_view str, std::uint32_t tag) const {
+    std::size_t mask = slots.size() - 1;
+    std::size_t slot = tag & mask;
+    while (slots[slot] != EMPTY) {
+        if (static_cast<std::uint32_t>(slots[slot] >> 32) == tag && nameOf(static_cast<CourseId>(slots[slot])) == str) break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Double the table and re-place every entry. The tags say where each one goes, so no string is rehashed.
+void StringPool::grow() {
+    std::vector<std::uint64_t> old(slots.empty() ? 64 : slots.size() * 2, EMPTY);
+    old.swap(slots);
+    std::size_t mask = slots.size() - 1;
+    for (std::uint64_t entry : old) {
+        if (entry == EMPTY) continue;
+        std::size_t slot = static_cast<std::size_t>(entry >> 32) & mask;
+        while (slots[slot] != EMPTY) slot = (slot + 1) & mask;
+        slots[slot] = entry;
+    }
+}
+
+// Return the id for a course number, handing out the next id the first time it is seen.
+CourseId StringPool::intern(std::string_view courseNumber) {
+    if ((names.size() + 1) * 4 > slots.size() * 3) { // keep the table at most 3/4 full
+        grow();
+    }
+    std::uint32_t tag = static_cast<std::uint32_t>(hashOf(courseNumber) >> 32);
+    std::size_t slot = slotFor(courseNumber, tag);
+    if (slots[slot] == EMPTY) {
+        slots[slot] = (static_cast<std::uint64_t>(tag) << 32) | names.size();
+        names.push_back(append(courseNumber));
+        keys.push_back(packKey(courseNumber));
+    }
+    return static_cast<CourseId>(slots[slot]);
+}
+
+// Look a course number up without adding it.
+CourseId StringPool::find(std::string_view courseNumber) const {
+    if (slots.empty()) return NO_ID;
+    std::uint64_t entry = slots[slotFor(courseNumber, static_cast<std::uint32_t>(hashOf(courseNumber) >> 32))];
+    return entry == EMPTY ? NO_ID : static_cast<CourseId>(entry);
+}
+
+// Append a string to the text block.
+PoolString StringPool::append(std::string_view str) {
+    PoolString ref = { static_cast<std::uint32_t>(text.size()), static_cast<std::uint32_t>(str.size()) };
+    text.append(str.data(), str.size());
+    return ref;
+}
+
+// Drop every string and id.
+void StringPool::clear() {
+    text.clear();
+    names.clear();
+    keys.clear();
+    slots.clear();
+}
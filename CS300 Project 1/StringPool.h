@@ -0,0 +1,70 @@
+//=========================================================================
+// Name        : StringPool.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Shared string pool that interns course numbers as dense ids
+//=========================================================================
+
+#pragma once
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// dense id handed out for each distinct course number
+typedef std::uint32_t CourseId;
+
+// a string stored in the pool's text block
+struct PoolString {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+// StringPool keeps every course string back to back in one text block.
+// Course numbers are interned: each distinct number gets a dense CourseId the
+// first time it is seen, so equal numbers compare as equal integers. Every id
+// also carries the first 8 bytes of its number packed big-endian, which orders
+// ids like their strings with one integer compare for typical course numbers.
+class StringPool {
+public:
+    static constexpr CourseId NO_ID = static_cast<CourseId>(-1);
+
+private:
+    std::string text;                 // every string, back to back
+    std::vector<PoolString> names;    // id -> course number in text
+    std::vector<std::uint64_t> keys;  // id -> packed 8-byte prefix of the number
+    std::vector<std::uint64_t> slots; // open-addressing table, high half is a hash tag and low half the id, EMPTY when unused
+
+    static constexpr std::uint64_t EMPTY = static_cast<std::uint64_t>(-1);
+
+    static std::uint64_t hashOf(std::string_view str);
+    std::size_t slotFor(std::string_view str, std::uint32_t tag) const;
+    void grow();
+
+public:
+    static std::uint64_t packKey(std::string_view courseNumber);
+
+    CourseId intern(std::string_view courseNumber);
+    CourseId find(std::string_view courseNumber) const; // NO_ID when never interned
+    PoolString append(std::string_view str);             // store a string without interning it
+    void clear();
+
+    std::size_t size() const { return names.size(); }
+
+    std::string_view nameOf(CourseId id) const { return view(names[id]); }
+    std::uint64_t keyOf(CourseId id) const { return keys[id]; }
+    std::string_view view(PoolString str) const { return std::string_view(text.data() + str.offset, str.length); }
+
+    // order two ids like their course numbers, full compares only when the prefixes tie
+    bool less(CourseId a, CourseId b) const {
+        if (keys[a] != keys[b]) return keys[a] < keys[b];
+        return a != b && nameOf(a) < nameOf(b);
+    }
+};
+
+#endif // STRINGPOOL_H
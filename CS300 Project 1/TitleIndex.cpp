@@ -0,0 +1,440 @@
+//=========================================================================
+// Name        : TitleIndex.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Word and trigram index over course titles for title search
+//=========================================================================
+
+#include "TitleIndex.h"
+#include "BinarySearchTree.h"
+
+#include <algorithm>     // For std::sort and the heap functions
+#include <functional>    // For walking the tiers of a query
+#include <numeric>       // For std::iota
+#include <unordered_map> // For numbering the distinct words
+
+// Check if a byte belongs to a word. Bytes of UTF-8 sequences count, so accented titles keep their words whole.
+static bool isWordByte(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u >= '0' && u <= '9') || (u >= 'A' && u <= 'Z') || (u >= 'a' && u <= 'z') || u >= 0x80;
+}
+
+// Cut the next word off the front of the text, empty when none are left.
+static std::string_view NextWord(std::string_view& text) {
+    std::size_t start = 0;
+    while (start < text.size() && !isWordByte(text[start])) ++start;
+    std::size_t end = start;
+    while (end < text.size() && isWordByte(text[end])) ++end;
+    std::string_view word = text.substr(start, end - start);
+    text.remove_prefix(end);
+    return word;
+}
+
+// Pack three bytes of a word into a trigram key.
+static std::uint32_t gramOf(const char* bytes) {
+    return (static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[0])) << 16)
+        | (static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[1])) << 8)
+        | static_cast<unsigned char>(bytes[2]);
+}
+
+// Order postings by word position, then title length, then course.
+static bool postingBefore(std::uint16_t positionA, std::uint16_t lengthA, std::uint32_t courseA,
+    std::uint16_t positionB, std::uint16_t lengthB, std::uint32_t courseB) {
+    if (positionA != positionB) return positionA < positionB;
+    if (lengthA != lengthB) return lengthA < lengthB;
+    return courseA < courseB;
+}
+
+// Build the index from every course in the tree, in sorted order.
+void TitleIndex::build(const BinarySearchTree& bst) {
+    clear();
+
+    // keep every number and fold every title into one buffer, so the words can be views into it
+    std::string folded;
+    std::vector<std::size_t> titleStart; // course index -> offset in folded, one extra entry at the end
+    for (const CourseCursor& course : bst) {
+        std::string_view number = course.number();
+        numbers.push_back({ static_cast<std::uint32_t>(text.size()), static_cast<std::uint32_t>(number.size()) });
+        text.append(number.data(), number.size());
+
+        std::string_view title = course.title();
+        titleStart.push_back(folded.size());
+        folded.resize(folded.size() + title.size());
+        foldUpper(title.data(), title.size(), &folded[folded.size() - title.size()]);
+    }
+    titleStart.push_back(folded.size());
+
+    // number the distinct words in order of first use
+    std::unordered_map<std::string_view, std::uint32_t> firstUse;
+    std::vector<std::string_view> distinct;
+    std::vector<std::uint32_t> uses; // the provisional word id of every title word
+    titleFirst.reserve(numbers.size() + 1);
+    for (std::size_t c = 0; c < numbers.size(); ++c) {
+        titleFirst.push_back(static_cast<std::uint32_t>(uses.size()));
+        std::string_view title(folded.data() + titleStart[c], titleStart[c + 1] - titleStart[c]);
+        for (std::string_view word = NextWord(title); !word.empty(); word = NextWord(title)) {
+            auto inserted = firstUse.emplace(word, static_cast<std::uint32_t>(distinct.size()));
+            if (inserted.second) {
+                distinct.push_back(word);
+            }
+            uses.push_back(inserted.first->second);
+        }
+    }
+    titleFirst.push_back(static_cast<std::uint32_t>(uses.size()));
+
+    // sort the words so word starts form contiguous runs, then renumber the uses
+    std::vector<std::uint32_t> order(distinct.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&distinct](std::uint32_t a, std::uint32_t b) { return distinct[a] < distinct[b]; });
+    std::vector<std::uint32_t> rank(distinct.size());
+    words.reserve(distinct.size());
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        rank[order[i]] = i;
+        std::string_view word = distinct[order[i]];
+        words.push_back({ static_cast<std::uint32_t>(text.size()), static_cast<std::uint32_t>(word.size()) });
+        text.append(word.data(), word.size());
+    }
+    titleWords.resize(uses.size());
+    for (std::size_t i = 0; i < uses.size(); ++i) {
+        titleWords[i] = rank[uses[i]];
+    }
+
+    // postings, counted per word, placed, then put in ranking order
+    postingFirst.assign(words.size() + 1, 0);
+    for (std::uint32_t word : titleWords) {
+        ++postingFirst[word + 1];
+    }
+    for (std::size_t w = 0; w < words.size(); ++w) {
+        postingFirst[w + 1] += postingFirst[w];
+    }
+    postings.resize(titleWords.size());
+    std::vector<std::uint32_t> next(postingFirst.begin(), postingFirst.end() - 1);
+    for (std::uint32_t c = 0; c < numbers.size(); ++c) {
+        std::size_t length = std::min<std::size_t>(titleStart[c + 1] - titleStart[c], 0xFFFF);
+        for (std::uint32_t i = titleFirst[c]; i < titleFirst[c + 1]; ++i) {
+            std::size_t position = std::min<std::size_t>(i - titleFirst[c], 0xFFFF);
+            postings[next[titleWords[i]]++] = { c, static_cast<std::uint16_t>(position), static_cast<std::uint16_t>(length) };
+        }
+    }
+    for (std::size_t w = 0; w < words.size(); ++w) {
+        std::sort(postings.begin() + postingFirst[w], postings.begin() + postingFirst[w + 1], [](const Posting& a, const Posting& b) {
+            return postingBefore(a.position, a.titleLength, a.course, b.position, b.titleLength, b.course);
+        });
+    }
+
+    // trigrams of every word, as (trigram, word) pairs sorted into runs
+    std::vector<std::uint64_t> pairs;
+    for (std::uint32_t w = 0; w < words.size(); ++w) {
+        std::string_view word = wordOf(w);
+        for (std::size_t i = 0; i + 3 <= word.size(); ++i) {
+            pairs.push_back((static_cast<std::uint64_t>(gramOf(word.data() + i)) << 32) | w);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end()); // a word repeating a trigram is listed once
+    gramWords.reserve(pairs.size());
+    for (std::uint64_t pair : pairs) {
+        std::uint32_t gram = static_cast<std::uint32_t>(pair >> 32);
+        if (gramKeys.empty() || gramKeys.back() != gram) {
+            gramKeys.push_back(gram);
+            gramFirst.push_back(static_cast<std::uint32_t>(gramWords.size()));
+        }
+        gramWords.push_back(static_cast<std::uint32_t>(pair));
+    }
+    gramFirst.push_back(static_cast<std::uint32_t>(gramWords.size()));
+}
+
+// Drop the index.
+void TitleIndex::clear() {
+    text.clear();
+    words.clear();
+    numbers.clear();
+    postingFirst.clear();
+    postings.clear();
+    titleFirst.clear();
+    titleWords.clear();
+    gramKeys.clear();
+    gramFirst.clear();
+    gramWords.clear();
+}
+
+// Bytes held by the index.
+std::size_t TitleIndex::memoryBytes() const {
+    return text.capacity() + words.capacity() * sizeof(PoolString) + numbers.capacity() * sizeof(PoolString)
+        + postingFirst.capacity() * sizeof(std::uint32_t) + postings.capacity() * sizeof(Posting)
+        + titleFirst.capacity() * sizeof(std::uint32_t) + titleWords.capacity() * sizeof(std::uint32_t)
+        + (gramKeys.capacity() + gramFirst.capacity() + gramWords.capacity()) * sizeof(std::uint32_t);
+}
+
+// How a title word matches a query word, both folded.
+TitleIndex::MatchKind TitleIndex::matchOf(std::string_view word, std::string_view queryWord) {
+    if (word.compare(0, queryWord.size(), queryWord) == 0) {
+        return word.size() == queryWord.size() ? Whole : Start;
+    }
+    if (queryWord.size() >= 3 && word.find(queryWord, 1) != std::string_view::npos) {
+        return Inside;
+    }
+    return NoMatch;
+}
+
+// Collect the dictionary words matching a query word, returning how many postings they have.
+std::size_t TitleIndex::matchWords(std::string_view queryWord, std::vector<WordMatch>& matches) const {
+    std::size_t total = 0;
+
+    // words starting with the query word sit together in sorted order
+    auto first = std::lower_bound(words.begin(), words.end(), queryWord, [this](const PoolString& word, std::string_view key) {
+        return std::string_view(text.data() + word.offset, word.length) < key;
+    });
+    for (std::uint32_t w = static_cast<std::uint32_t>(first - words.begin()); w < words.size(); ++w) {
+        std::string_view word = wordOf(w);
+        if (word.compare(0, queryWord.size(), queryWord) != 0) break;
+        matches.push_back({ w, word.size() == queryWord.size() ? Whole : Start });
+        total += postingFirst[w + 1] - postingFirst[w];
+    }
+    if (queryWord.size() < 3) {
+        return total; // too short for a trigram
+    }
+
+    // words containing it further in all contain its rarest trigram, so only those are checked
+    std::size_t bestFirst = 0;
+    std::size_t bestEnd = 0;
+    bool haveBest = false;
+    for (std::size_t i = 0; i + 3 <= queryWord.size(); ++i) {
+        auto gram = std::lower_bound(gramKeys.begin(), gramKeys.end(), gramOf(queryWord.data() + i));
+        if (gram == gramKeys.end() || *gram != gramOf(queryWord.data() + i)) {
+            return total; // no word has this trigram
+        }
+        std::size_t g = static_cast<std::size_t>(gram - gramKeys.begin());
+        if (!haveBest || gramFirst[g + 1] - gramFirst[g] < bestEnd - bestFirst) {
+            bestFirst = gramFirst[g];
+            bestEnd = gramFirst[g + 1];
+            haveBest = true;
+        }
+    }
+    for (std::size_t i = bestFirst; i < bestEnd; ++i) {
+        std::uint32_t w = gramWords[i];
+        if (matchOf(wordOf(w), queryWord) == Inside) {
+            matches.push_back({ w, Inside });
+            total += postingFirst[w + 1] - postingFirst[w];
+        }
+    }
+    return total;
+}
+
+// a title checked through its own words costs about as much as marking this many postings in a per-course array
+static const std::size_t POSTINGS_PER_TITLE_CHECK = 64;
+
+// Find the courses whose titles match every word of the query, best first.
+// A title's score is the sum of how well each query word matches it, so the titles fall into tiers,
+// one per choice of match kind for every query word, and the tiers are searched best total first.
+// Each tier is driven by the query word with the fewest postings of its kind there. Those postings
+// are merged in ranking order and a title is taken when every query word matches it exactly as the
+// tier says, so each title turns up in one tier only. Within a tier the titles come in ranking
+// order, so a tier stops after limit of them, and the search stops after the first total that
+// fills the results.
+// A tier whose words are common but seldom share a title still reads every driver posting, each
+// checked through its title's words. Once those checks would cost more than reading every posting
+// of the query once, the search starts over with the best kind of each query word marked per
+// course, so a check is one byte per query word and the postings are read in the order they are
+// stored. The results are the same either way.
+std::vector<TitleMatch> TitleIndex::search(std::string_view query, std::size_t limit) const {
+    std::vector<TitleMatch> results;
+    FoldedKey folded(query);
+    std::vector<std::string_view> queryWords;
+    std::string_view rest = folded.view();
+    for (std::string_view word = NextWord(rest); !word.empty(); word = NextWord(rest)) {
+        queryWords.push_back(word);
+    }
+    if (queryWords.empty() || limit == 0) {
+        return results;
+    }
+    std::size_t n = queryWords.size();
+
+    // the dictionary words each query word matches and their postings per kind, a query word
+    // matching nothing rules out every title
+    std::vector<std::vector<WordMatch>> matches(n);
+    std::vector<std::size_t> postingsOfKind(n * (Whole + 1), 0); // query word q, kind k at q * (Whole + 1) + k
+    std::size_t allPostings = 0;
+    for (std::size_t q = 0; q < n; ++q) {
+        std::size_t total = matchWords(queryWords[q], matches[q]);
+        if (total == 0) {
+            return results;
+        }
+        allPostings += total;
+        for (const WordMatch& match : matches[q]) {
+            postingsOfKind[q * (Whole + 1) + match.kind] += postingFirst[match.word + 1] - postingFirst[match.word];
+        }
+    }
+
+    // how each dictionary word matches each query word, so checking a title is a lookup per word
+    std::vector<std::vector<unsigned char>> kindOf(n);
+    for (std::size_t q = 0; q < n; ++q) {
+        kindOf[q].assign(words.size(), NoMatch);
+        for (const WordMatch& match : matches[q]) {
+            kindOf[q][match.word] = static_cast<unsigned char>(match.kind);
+        }
+    }
+
+    struct Candidate {
+        std::uint32_t course;
+        unsigned score;
+        std::uint16_t position;
+        std::uint16_t titleLength;
+    };
+    auto better = [](const Candidate& a, const Candidate& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return postingBefore(a.position, a.titleLength, a.course, b.position, b.titleLength, b.course);
+    };
+
+    struct Head {
+        std::uint32_t at;  // next posting of the word
+        std::uint32_t end; // past its last posting
+    };
+    auto after = [this](const Head& a, const Head& b) { // heap order, the smallest posting on top
+        const Posting& pa = postings[a.at];
+        const Posting& pb = postings[b.at];
+        return postingBefore(pb.position, pb.titleLength, pb.course, pa.position, pa.titleLength, pa.course);
+    };
+    std::vector<Head> heads;
+    std::vector<unsigned> best(n);
+    std::size_t checksLeft = allPostings / POSTINGS_PER_TITLE_CHECK + limit; // title checks before starting over
+    std::vector<std::vector<unsigned char>> courseKind; // query word -> course -> best kind, once started over
+
+    // the best titles of one tier, tier[q] the kind query word q has to match with, appended to found
+    std::vector<MatchKind> tier(n);
+    std::vector<Candidate> found;
+    std::vector<Candidate> tierBest; // a heap with the worst kept title on top, while reading in stored order
+    auto searchTier = [&](unsigned score) {
+        std::size_t driver = 0;
+        for (std::size_t q = 1; q < n; ++q) {
+            if (postingsOfKind[q * (Whole + 1) + tier[q]] < postingsOfKind[driver * (Whole + 1) + tier[driver]]) {
+                driver = q;
+            }
+        }
+
+        if (!courseKind.empty()) { // every posting of the tier in stored order, keeping the best limit titles
+            tierBest.clear();
+            for (const WordMatch& match : matches[driver]) {
+                if (match.kind != tier[driver]) continue;
+                for (std::uint32_t at = postingFirst[match.word]; at < postingFirst[match.word + 1]; ++at) {
+                    const Posting& posting = postings[at];
+                    bool inTier = true;
+                    for (std::size_t q = 0; q < n && inTier; ++q) {
+                        inTier = courseKind[q][posting.course] == tier[q];
+                    }
+                    Candidate candidate = { posting.course, score, posting.position, posting.titleLength };
+                    if (!inTier || (tierBest.size() == limit && !better(candidate, tierBest.front()))) continue;
+                    bool isNew = true; // a title may hold several driver words, it is kept once, at its best
+                    for (Candidate& other : tierBest) {
+                        if (other.course != candidate.course) continue;
+                        isNew = false;
+                        if (better(candidate, other)) {
+                            other = candidate;
+                            std::make_heap(tierBest.begin(), tierBest.end(), better);
+                        }
+                        break;
+                    }
+                    if (!isNew) continue;
+                    if (tierBest.size() == limit) {
+                        std::pop_heap(tierBest.begin(), tierBest.end(), better);
+                        tierBest.pop_back();
+                    }
+                    tierBest.push_back(candidate);
+                    std::push_heap(tierBest.begin(), tierBest.end(), better);
+                }
+            }
+            found.insert(found.end(), tierBest.begin(), tierBest.end());
+            return;
+        }
+
+        heads.clear();
+        for (const WordMatch& match : matches[driver]) {
+            if (match.kind == tier[driver]) {
+                heads.push_back({ postingFirst[match.word], postingFirst[match.word + 1] });
+            }
+        }
+        std::make_heap(heads.begin(), heads.end(), after);
+        std::size_t first = found.size();
+        while (!heads.empty() && found.size() - first < limit && checksLeft > 0) {
+            std::pop_heap(heads.begin(), heads.end(), after);
+            Head& head = heads.back();
+            const Posting& posting = postings[head.at];
+            --checksLeft;
+
+            // the title belongs to this tier when each query word's best match in it is the tier's kind
+            std::fill(best.begin(), best.end(), static_cast<unsigned>(NoMatch));
+            for (std::uint32_t w = titleFirst[posting.course]; w < titleFirst[posting.course + 1]; ++w) {
+                for (std::size_t q = 0; q < n; ++q) {
+                    best[q] = std::max<unsigned>(best[q], kindOf[q][titleWords[w]]);
+                }
+            }
+            bool inTier = true;
+            for (std::size_t q = 0; q < n && inTier; ++q) {
+                inTier = best[q] == static_cast<unsigned>(tier[q]);
+            }
+            for (std::size_t i = first; i < found.size() && inTier; ++i) { // a title may hold several driver words, it is kept once
+                inTier = found[i].course != posting.course;
+            }
+            if (inTier) {
+                found.push_back({ posting.course, score, posting.position, posting.titleLength });
+            }
+
+            if (++head.at < head.end) {
+                std::push_heap(heads.begin(), heads.end(), after);
+            }
+            else {
+                heads.pop_back();
+            }
+        }
+    };
+
+    // every tier with a given total, choosing the kinds of query words q on, with score still to make up
+    std::function<void(std::size_t, unsigned, unsigned)> eachTier = [&](std::size_t q, unsigned total, unsigned score) {
+        if (q == n) {
+            if (score == 0 && (checksLeft > 0 || !courseKind.empty())) searchTier(total);
+            return;
+        }
+        unsigned wordsLeft = static_cast<unsigned>(n - q - 1);
+        for (MatchKind kind : { Whole, Start, Inside }) {
+            if (postingsOfKind[q * (Whole + 1) + kind] == 0) continue;
+            if (kind > score || score - kind < wordsLeft * Inside || score - kind > wordsLeft * Whole) continue;
+            tier[q] = kind;
+            eachTier(q + 1, total, score - kind);
+        }
+    };
+
+    // the tiers best total first, until the results are full
+    std::vector<Candidate> kept;
+    auto searchTiers = [&]() {
+        kept.clear();
+        for (unsigned total = static_cast<unsigned>(n) * Whole; total >= n * Inside && kept.size() < limit; --total) {
+            found.clear();
+            eachTier(0, total, total);
+            if (checksLeft == 0 && courseKind.empty()) return; // out of title checks, the results may be incomplete
+            std::sort(found.begin(), found.end(), better); // the tiers of one total, merged
+            for (std::size_t i = 0; i < found.size() && kept.size() < limit; ++i) {
+                kept.push_back(found[i]);
+            }
+        }
+    };
+    searchTiers();
+    if (checksLeft == 0 && courseKind.empty()) { // start over with every query word's best kind marked per course
+        courseKind.assign(n, std::vector<unsigned char>(numbers.size(), NoMatch));
+        for (std::size_t q = 0; q < n; ++q) {
+            for (const WordMatch& match : matches[q]) {
+                for (std::uint32_t at = postingFirst[match.word]; at < postingFirst[match.word + 1]; ++at) {
+                    unsigned char& kind = courseKind[q][postings[at].course];
+                    kind = std::max(kind, static_cast<unsigned char>(match.kind));
+                }
+            }
+        }
+        searchTiers();
+    }
+
+    for (const Candidate& candidate : kept) {
+        const PoolString& number = numbers[candidate.course];
+        results.push_back({ std::string_view(text.data() + number.offset, number.length), candidate.score });
+    }
+    return results;
+}
@@ -0,0 +1,83 @@
+//=========================================================================
+// Name        : TitleIndex.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 10/17/26
+// Description : Word and trigram index over course titles for title search
+//=========================================================================
+
+#pragma once
+#ifndef TITLEINDEX_H
+#define TITLEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "StringPool.h"
+
+class BinarySearchTree;
+
+// one course found by a title search
+struct TitleMatch {
+    std::string_view courseNumber;
+    unsigned score; // 3 per query word matched exactly, 2 per word start, 1 per fragment inside a word
+};
+
+// TitleIndex answers title searches without scanning the catalog.
+// Titles are split into words folded to uppercase. Every distinct word is kept once,
+// in sorted order, with the courses using it, so a word or word start is found by
+// binary search. Words are also indexed by their three-byte fragments (trigrams),
+// so a fragment from the middle of a word only checks the words sharing its rarest
+// trigram. Fragments under three bytes match the start of words only.
+// Every query word has to match. Results are ranked by score, then by how early the
+// rarest matching query word sits in the title, then shorter titles first.
+class TitleIndex {
+public:
+    static constexpr std::size_t DEFAULT_LIMIT = 10;
+
+private:
+    // how well one title word matches one query word
+    enum MatchKind : unsigned { NoMatch = 0, Inside = 1, Start = 2, Whole = 3 };
+
+    // one use of a word in a title, sorted per word by position, then title length
+    struct Posting {
+        std::uint32_t course;      // index into numbers
+        std::uint16_t position;    // word position in the title
+        std::uint16_t titleLength; // title length in bytes, capped
+    };
+
+    // a dictionary word matching a query word
+    struct WordMatch {
+        std::uint32_t word;
+        MatchKind kind;
+    };
+
+    std::string text;                     // every course number, then every distinct word
+    std::vector<PoolString> words;        // word id -> word, in sorted order
+    std::vector<PoolString> numbers;      // course index -> course number, in sorted order
+    std::vector<std::uint32_t> postingFirst; // word id -> first posting, one extra entry at the end
+    std::vector<Posting> postings;
+    std::vector<std::uint32_t> titleFirst; // course index -> first entry in titleWords, one extra entry at the end
+    std::vector<std::uint32_t> titleWords; // the word ids of every title, in title order
+    std::vector<std::uint32_t> gramKeys;   // distinct trigrams, sorted
+    std::vector<std::uint32_t> gramFirst;  // trigram -> first entry in gramWords, one extra entry at the end
+    std::vector<std::uint32_t> gramWords;  // word ids containing each trigram, sorted
+
+    std::string_view wordOf(std::uint32_t word) const { return std::string_view(text.data() + words[word].offset, words[word].length); }
+    static MatchKind matchOf(std::string_view word, std::string_view queryWord);
+    std::size_t matchWords(std::string_view queryWord, std::vector<WordMatch>& matches) const;
+
+public:
+    void build(const BinarySearchTree& bst);
+    void clear();
+    bool isEmpty() const { return numbers.empty(); }
+    std::size_t courseCount() const { return numbers.size(); }
+    std::size_t wordCount() const { return words.size(); }
+    std::size_t memoryBytes() const;
+
+    std::vector<TitleMatch> search(std::string_view query, std::size_t limit = DEFAULT_LIMIT) const;
+};
+
+#endif // TITLEINDEX_H
@@ -1,86 +1,536 @@
-//==============================================================
-// Name        : main.cpp
-// Author      : John St Hilaire
-// Version     : 1.0
-// Last Updated : 2/25/23
-// Description : Main C++ file for Project 1 for CS300 at SNHU
-//==============================================================
-
-
-#include <iostream> // for user interaction
-#include <string> // for string type
-#include "BinarySearchTree.h" // for Binary Search Tree Class
-#include "menuFunctions.h"  // for functions called by menu
-
-
-
-// Main Menu
-int main() {
-
-    BinarySearchTree* dataStructure = new BinarySearchTree(); // create a new binary search tree instance
-
-    // display until the user decides to exit
-    while (true) {
-        std::cout << "Welcome to the course planner.\n\n";
-        std::cout << "1. Load Data Structure\n";
-        std::cout << "2. Print Courses List\n";
-        std::cout << "3. Print Course.\n";
-        std::cout << "4. Exit\n\n";
-
-        std::string choice;
-        std::cout << "What would you like to do? ";
-        std::cin >> choice;
-
-        // load data structure
-        if (choice == "1") {
-            std::string filename;
-            std::cout << "Enter filename (default is courses.csv): ";
-            std::cin >> filename;
-            bool success = LoadDataStructure(*dataStructure, filename);
-            if (success) {
-                std::cout << "Data loaded successfully.\n\n";
-            }
-            else {
-                std::cout << "Failed to load data.\n";
-            }
-        }
-
-        // print course information in alphanumeric order
-        else if (choice == "2") {
-            if (!DataStructureIsEmpty(*dataStructure)) {
-                PrintCourseList(*dataStructure);
-            }
-            else {
-                std::cout << "Data structure is empty. Load data first.\n";
-            }
-        }
-
-        // print info on individual course
-        else if (choice == "3") {
-            if (!DataStructureIsEmpty(*dataStructure)) {
-                std::string courseID;
-                std::cout << "Enter course ID: ";
-                std::cin >> courseID;
-                PrintCourseInformation(*dataStructure, courseID);
-            }
-            else {
-                std::cout << "Data structure is empty. Load data first.\n";
-            }
-        }
-
-        // exit program and clean memory
-        else if (choice == "4") {
-            ExitProgram();
-            break;  // exit the while loop
-        }
-        else { // handle invalid menu options
-            std::cout << choice << " is not a valid option." << std::endl;
-        }
-    }
-
-    delete dataStructure; // cleanup before exiting the program
-
-    return 0;  // indicate successful program termination
-}
-
-
+//==============================================================
+// Name        : main.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 2/25/23
+// Description : Main C++ file for Project 1 for CS300 at SNHU
+//==============================================================
+
+
+#include <iostream> // for user interaction
+#include <string> // for string type
+#include <csignal> // for stopping the course server
+#include <cstdlib> // for reading numeric arguments
+#include <algorithm> // for std::max
+#include <limits> // for skipping the rest of a bad line
+#include "BinarySearchTree.h" // for Binary Search Tree Class
+#include "menuFunctions.h"  // for functions called by menu
+#include "PrerequisiteGraph.h" // for prerequisite closure queries
+#include "CatalogReloader.h" // for reloading only the changed rows
+#include "FileWatcher.h" // for noticing when the loaded file changes
+#include "TitleIndex.h" // for searching course titles
+#include "CourseServer.h" // for serving queries to other processes
+#include "KioskCatalog.h" // for the catalog compiled into kiosk builds
+
+static CourseServer* activeServer = nullptr; // the server SIGINT and SIGTERM stop
+
+// Signal handler for the served mode, it only wakes the server's loops.
+static void StopServer(int) {
+    if (activeServer != nullptr) {
+        activeServer->stop();
+    }
+}
+
+
+
+// Main Menu
+int main(int argc, char* argv[]) {
+
+    // process command line arguments, --stream and --serial select the single threaded loaders for comparison,
+    // --no-snapshot always parses the csv and leaves the .snap file alone,
+    // --watch reloads the changed rows of the loaded file whenever it is saved,
+    // --bench-titles times title searches after every load,
+    // --stress-reload times lookups from reader threads while the loaded file is reloaded in the background,
+    // --serve <socket> <file> loads file once and answers queries on a Unix socket instead of showing the menu,
+    // with --workers <n> worker threads, and --load-test <socket> measures such a server with --clients <n> clients,
+    // --plan-batch <catalog> <students> plans every student in the file on every core and quits,
+    // --radix answers lookups and listings from a radix index over the course numbers,
+    // --bench-index <n> compares the lookup paths on generated catalogs of 10^4 up to n courses and quits,
+    // --bench-arena <n> times loading and tearing down the tree with arena slabs and with one allocation per node,
+    // on generated catalogs of 10^5 up to n courses, and quits,
+    // --bench-lookups <n> times case-insensitive lookups on generated n course catalogs and quits, builds with
+    // COURSE_COUNT_ALLOCATIONS defined also count the heap allocations per lookup,
+    // --bench-graph <n> times building the prerequisite graph of a generated n course catalog and querying it, and quits,
+    // --export <catalog> <csv|jsonl|bin> <file> writes the catalog out in that format and quits, - for standard output,
+    // --generate-catalog <catalog> <header> writes the catalog out as KioskCatalog.h for kiosk builds and quits,
+    // --kiosk answers the listing, lookup and prefix queries from the compiled catalog, with nothing to load,
+    // --bench-static <catalog> compares lookups in the compiled catalog with the tree loaded from catalog and quits,
+    // any other argument names a file to start loading in the background at launch
+    LoadMode loadMode = LoadMode::Parallel;
+    bool useSnapshot = true;
+    bool watchFile = false;
+    bool benchTitles = false;
+    bool stressReload = false;
+    std::string servePath; // socket to serve on, empty for the menu
+    std::string serveFile;
+    std::size_t workerCount = CourseServer::DEFAULT_WORKERS;
+    std::string loadTestPath; // socket of a server to measure
+    std::size_t clientCount = 4;
+    std::string launchFile; // loaded in the background from launch
+    std::string planCatalog; // catalog and students file for --plan-batch
+    std::string planStudents;
+    bool radixIndex = false;
+    std::size_t benchIndexKeys = 0; // largest catalog for --bench-index, 0 when not asked for
+    std::size_t benchArenaCourses = 0; // largest catalog for --bench-arena, 0 when not asked for
+    std::size_t benchGraphCourses = 0; // catalog size for --bench-graph, 0 when not asked for
+    std::size_t benchLookupCourses = 0; // catalog size for --bench-lookups, 0 when not asked for
+    std::string exportCatalog; // catalog, format and destination for --export
+    std::string exportFormat;
+    std::string exportPath;
+    std::string generateCatalog; // catalog and header for --generate-catalog
+    std::string generateHeader;
+    bool kiosk = false;
+    std::string benchStaticFile; // catalog for --bench-static
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--stream") {
+            loadMode = LoadMode::Stream;
+        }
+        else if (std::string(argv[i]) == "--serial") {
+            loadMode = LoadMode::Mapped;
+        }
+        else if (std::string(argv[i]) == "--no-snapshot") {
+            useSnapshot = false;
+        }
+        else if (std::string(argv[i]) == "--watch") {
+            watchFile = true;
+        }
+        else if (std::string(argv[i]) == "--bench-titles") {
+            benchTitles = true;
+        }
+        else if (std::string(argv[i]) == "--stress-reload") {
+            stressReload = true;
+        }
+        else if (std::string(argv[i]) == "--serve" && i + 2 < argc) {
+            servePath = argv[++i];
+            serveFile = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--workers" && i + 1 < argc) {
+            workerCount = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::string(argv[i]) == "--load-test" && i + 1 < argc) {
+            loadTestPath = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--clients" && i + 1 < argc) {
+            clientCount = std::max<std::size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::string(argv[i]) == "--plan-batch" && i + 2 < argc) {
+            planCatalog = argv[++i];
+            planStudents = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--radix") {
+            radixIndex = true;
+        }
+        else if (std::string(argv[i]) == "--bench-index" && i + 1 < argc) {
+            benchIndexKeys = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::string(argv[i]) == "--bench-arena" && i + 1 < argc) {
+            benchArenaCourses = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::string(argv[i]) == "--bench-lookups" && i + 1 < argc) {
+            benchLookupCourses = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::string(argv[i]) == "--bench-graph" && i + 1 < argc) {
+            benchGraphCourses = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::string(argv[i]) == "--export" && i + 3 < argc) {
+            exportCatalog = argv[++i];
+            exportFormat = argv[++i];
+            exportPath = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--generate-catalog" && i + 2 < argc) {
+            generateCatalog = argv[++i];
+            generateHeader = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--kiosk") {
+            kiosk = true;
+        }
+        else if (std::string(argv[i]) == "--bench-static" && i + 1 < argc) {
+            benchStaticFile = argv[++i];
+        }
+        else if (argv[i][0] != '-') {
+            launchFile = argv[i];
+        }
+    }
+
+    // time the lookup paths on generated catalogs, then quit
+    if (benchIndexKeys > 0) {
+        BenchmarkCourseIndexes(benchIndexKeys);
+        return 0;
+    }
+
+    // time the node arena against one allocation per node, then quit
+    if (benchArenaCourses > 0) {
+        BenchmarkNodeArena(benchArenaCourses);
+        return 0;
+    }
+
+    // time lookups and count their allocations, then quit
+    if (benchLookupCourses > 0) {
+        BenchmarkLookupAllocations(benchLookupCourses);
+        return 0;
+    }
+
+    // time the prerequisite graph on a generated catalog, then quit
+    if (benchGraphCourses > 0) {
+        BenchmarkPrerequisiteGraph(benchGraphCourses);
+        return 0;
+    }
+
+    // compile a catalog into the header kiosk builds include, then quit
+    if (!generateCatalog.empty()) {
+        return GenerateStaticCatalog(generateCatalog, generateHeader) ? 0 : 1;
+    }
+
+    // time the compiled catalog against the tree, then quit
+    if (!benchStaticFile.empty()) {
+        BenchmarkStaticCatalog(KioskCatalog::CATALOG, benchStaticFile);
+        return 0;
+    }
+
+    // the kiosk serves the catalog it was built with, there is nothing to load and nothing changes
+    if (kiosk) {
+        while (true) {
+            std::cout << "Welcome to the course planner.\n\n";
+            std::cout << "2. Print Courses List\n";
+            std::cout << "3. Print Course.\n";
+            std::cout << "4. Exit\n";
+            std::cout << "5. Print Courses By Prefix\n\n";
+
+            std::string choice;
+            std::cout << "What would you like to do? ";
+            std::cin >> choice;
+            if (choice == "2") {
+                PrintCourseList(KioskCatalog::CATALOG);
+            }
+            else if (choice == "3") {
+                std::string courseID;
+                std::cout << "Enter course ID: ";
+                std::cin >> courseID;
+                PrintCourseInformation(KioskCatalog::CATALOG, courseID);
+            }
+            else if (choice == "5") {
+                std::string prefix;
+                std::cout << "Enter course number prefix: ";
+                std::cin >> prefix;
+                PrintCoursesWithPrefix(KioskCatalog::CATALOG, prefix);
+            }
+            else if (choice == "4" || !std::cin) {
+                ExitProgram();
+                return 0;
+            }
+            else {
+                std::cout << choice << " is not a valid option." << std::endl;
+            }
+        }
+    }
+
+    BinarySearchTree* dataStructure = new BinarySearchTree(); // create a new binary search tree instance
+    dataStructure->useRadixIndex(radixIndex);
+    PrerequisiteGraph prerequisiteGraph; // compiled from the tree, in the menu the first time a plan needs it after a change
+    CatalogReloader reloader; // row hashes of the loaded file, for reloads
+    FileWatcher watcher; // the loaded file, when --watch is on
+    std::string loadedFile; // the file the tree mirrors, empty after merging a second file into it
+
+    // measure a server that is already running, then quit
+    if (!loadTestPath.empty()) {
+        BenchmarkCourseServer(loadTestPath, clientCount);
+        delete dataStructure;
+        return 0;
+    }
+
+    // plan a file of students against a catalog, then quit
+    if (!planStudents.empty()) {
+        if (!LoadDataStructure(*dataStructure, planCatalog, loadMode, useSnapshot)) {
+            std::cout << "Failed to load data.\n";
+            delete dataStructure;
+            return 1;
+        }
+        dataStructure->thaw(); // the graph is built from the nodes, which a snapshot start skips
+        prerequisiteGraph.build(*dataStructure);
+        if (!PlanStudentBatch(prerequisiteGraph, planStudents)) {
+            std::cout << "Could not read " << planStudents << std::endl;
+        }
+        delete dataStructure;
+        return 0;
+    }
+
+    // export a catalog, then quit
+    if (!exportCatalog.empty()) {
+        // the load messages go to standard error, standard output may be carrying the export
+        std::streambuf* console = exportPath == "-" ? std::cout.rdbuf(std::cerr.rdbuf()) : nullptr;
+        bool loaded = LoadDataStructure(*dataStructure, exportCatalog, loadMode, useSnapshot);
+        if (console != nullptr) {
+            std::cout.rdbuf(console);
+        }
+        bool exported = loaded && ExportDataStructure(*dataStructure, exportFormat, exportPath);
+        if (!loaded) {
+            std::cerr << "Failed to load data.\n";
+        }
+        delete dataStructure;
+        return exported ? 0 : 1;
+    }
+
+    // load the file once and serve it until interrupted, no menu
+    if (!servePath.empty()) {
+        if (!LoadDataStructure(*dataStructure, serveFile, loadMode, useSnapshot)) {
+            std::cout << "Failed to load data.\n";
+            delete dataStructure;
+            return 1;
+        }
+        dataStructure->thaw(); // prerequisite queries need the nodes, which a snapshot start skips
+        prerequisiteGraph.build(*dataStructure);
+        CourseServer server(*dataStructure, prerequisiteGraph);
+        bool started = server.start(servePath, workerCount);
+        if (started) {
+            activeServer = &server;
+            std::signal(SIGINT, StopServer);
+            std::signal(SIGTERM, StopServer);
+            std::cout << "Serving " << dataStructure->courseCount() << " courses on " << servePath << ", Ctrl+C stops.\n";
+            server.run();
+            activeServer = nullptr;
+        }
+        delete dataStructure;
+        return started ? 0 : 1;
+    }
+
+    TitleIndex titleIndex; // title words of the loaded courses
+    bool titleIndexCurrent = false; // false until the index is built for the current courses
+    bool prerequisiteGraphCurrent = false; // the same for the prerequisite graph
+
+    // the tree changed, so the prerequisite graph and the title index no longer match it. Neither is
+    // rebuilt here, each is built again the next time a choice needs it, so a load or a reload of a
+    // few rows doesn't pay for compiling the whole catalog
+    auto markIndexesStale = [&]() {
+        prerequisiteGraphCurrent = false;
+        titleIndexCurrent = false;
+    };
+
+    // take over a tree loaded from one file: its indexes are stale, and the file is followed for reloads and --watch
+    auto adoptLoad = [&](const std::string& filename) {
+        markIndexesStale();
+        reloader.reset(); // the hashes are taken from the tree on the first reload
+        loadedFile = filename;
+        if (watchFile) {
+            watcher.watch(filename);
+        }
+    };
+
+    // a file named on the command line starts loading right away, lookups answer while it loads
+    BackgroundLoader backgroundLoad;
+    if (!launchFile.empty()) {
+        if (!StartBackgroundLoad(*dataStructure, backgroundLoad, launchFile, useSnapshot)) {
+            std::cout << "Failed to load data.\n";
+        }
+        else if (!backgroundLoad.isLoading()) { // a current snapshot was loaded at once
+            adoptLoad(launchFile);
+        }
+    }
+
+    // display until the user decides to exit
+    while (true) {
+        std::cout << "Welcome to the course planner.\n\n";
+        std::cout << "1. Load Data Structure\n";
+        std::cout << "2. Print Courses List\n";
+        std::cout << "3. Print Course.\n";
+        std::cout << "4. Exit\n";
+        std::cout << "5. Print Courses By Prefix\n";
+        std::cout << "6. Search Course Titles\n";
+        std::cout << "7. Plan Semesters\n";
+        std::cout << "8. Export Catalog\n\n";
+
+        std::string choice;
+        std::cout << "What would you like to do? ";
+        std::cin >> choice;
+
+        // apply the saved changes of a watched file before acting on the choice
+        if (watcher.changed() && ReloadDataStructure(*dataStructure, reloader, loadedFile) && reloader.changes().total() > 0) {
+            markIndexesStale();
+        }
+
+        // while the launch file is loading, a course lookup answers from the rows parsed so far
+        // and every other choice waits for the whole file
+        if (backgroundLoad.isLoading()) {
+            if (choice == "3" && !backgroundLoad.isReady()) {
+                std::string courseID;
+                std::cout << "Enter course ID: ";
+                std::cin >> courseID;
+                PrintCourseWhileLoading(backgroundLoad, courseID);
+                continue;
+            }
+            if (choice == "4") {
+                backgroundLoad.cancel(); // no need to finish a load nobody will use
+                backgroundLoad.finish();
+            }
+            else {
+                if (!backgroundLoad.isReady()) {
+                    std::cout << "Waiting for " << launchFile << " to finish loading...\n";
+                }
+                if (FinishBackgroundLoad(*dataStructure, backgroundLoad, launchFile, useSnapshot)) {
+                    adoptLoad(launchFile);
+                }
+                else {
+                    std::cout << "Failed to load data.\n";
+                }
+            }
+        }
+
+        // load data structure
+        if (choice == "1") {
+            std::string filename;
+            std::cout << "Enter filename (default is courses.csv): ";
+            std::cin >> filename;
+            bool success;
+            if (!DataStructureIsEmpty(*dataStructure) && filename == loadedFile) {
+                // the same file again, only its changed rows are applied
+                success = ReloadDataStructure(*dataStructure, reloader, filename);
+                if (success && reloader.changes().total() > 0) {
+                    markIndexesStale();
+                }
+            }
+            else {
+                bool merging = !DataStructureIsEmpty(*dataStructure);
+                success = LoadDataStructure(*dataStructure, filename, loadMode, useSnapshot);
+                if (success) {
+                    markIndexesStale();
+                    reloader.reset(); // the hashes are taken from the tree on the first reload
+                    loadedFile = merging ? std::string() : filename; // a merged tree no longer mirrors one file
+                    if (watchFile && !merging) {
+                        watcher.watch(filename);
+                    }
+                    else {
+                        watcher.stop();
+                    }
+                }
+            }
+            if (success) {
+                std::cout << "Data loaded successfully.\n\n";
+                if (benchTitles) {
+                    if (!titleIndexCurrent) {
+                        titleIndex.build(*dataStructure);
+                        titleIndexCurrent = true;
+                    }
+                    BenchmarkTitleSearch(*dataStructure, titleIndex);
+                }
+                if (stressReload) {
+                    StressSnapshotReads(filename);
+                }
+            }
+            else {
+                std::cout << "Failed to load data.\n";
+            }
+        }
+
+        // print course information in alphanumeric order
+        else if (choice == "2") {
+            if (!DataStructureIsEmpty(*dataStructure)) {
+                PrintCourseList(*dataStructure);
+            }
+            else {
+                std::cout << "Data structure is empty. Load data first.\n";
+            }
+        }
+
+        // print info on individual course
+        else if (choice == "3") {
+            if (!DataStructureIsEmpty(*dataStructure)) {
+                std::string courseID;
+                std::cout << "Enter course ID: ";
+                std::cin >> courseID;
+                PrintCourseInformation(*dataStructure, courseID);
+            }
+            else {
+                std::cout << "Data structure is empty. Load data first.\n";
+            }
+        }
+
+        // print the courses whose number starts with a prefix, e.g. CSCI3 for the 300 level
+        else if (choice == "5") {
+            if (!DataStructureIsEmpty(*dataStructure)) {
+                std::string prefix;
+                std::cout << "Enter course number prefix: ";
+                std::cin >> prefix;
+                PrintCoursesWithPrefix(*dataStructure, prefix);
+            }
+            else {
+                std::cout << "Data structure is empty. Load data first.\n";
+            }
+        }
+
+        // search course titles by words or word fragments
+        else if (choice == "6") {
+            if (!DataStructureIsEmpty(*dataStructure)) {
+                std::string query;
+                std::cout << "Enter title words: ";
+                std::getline(std::cin >> std::ws, query); // the query may hold several words
+                if (!titleIndexCurrent) { // built on first use after a change
+                    titleIndex.build(*dataStructure);
+                    titleIndexCurrent = true;
+                }
+                PrintTitleSearch(*dataStructure, titleIndex, query);
+            }
+            else {
+                std::cout << "Data structure is empty. Load data first.\n";
+            }
+        }
+
+        // plan the terms a student needs to reach some target courses
+        else if (choice == "7") {
+            if (!DataStructureIsEmpty(*dataStructure)) {
+                std::string completed, targets;
+                std::size_t perTerm = 0;
+                std::cout << "Enter completed courses, or none: ";
+                std::getline(std::cin >> std::ws, completed);
+                std::cout << "Enter target courses: ";
+                std::getline(std::cin >> std::ws, targets);
+                std::cout << "Enter courses per term: ";
+                if (!(std::cin >> perTerm)) {
+                    std::cin.clear(); // not a number, plan one course a term
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // and drop it, so the menu doesn't read it as a choice
+                    perTerm = 1;
+                }
+                if (completed == "none") {
+                    completed.clear();
+                }
+                if (!prerequisiteGraphCurrent) { // built on first use after a change
+                    dataStructure->thaw(); // the graph is built from the nodes, which a snapshot start skips
+                    prerequisiteGraph.build(*dataStructure);
+                    prerequisiteGraphCurrent = true;
+                }
+                PrintSemesterPlan(prerequisiteGraph, completed, targets, perTerm);
+            }
+            else {
+                std::cout << "Data structure is empty. Load data first.\n";
+            }
+        }
+
+        // write the catalog out for other tools
+        else if (choice == "8") {
+            if (!DataStructureIsEmpty(*dataStructure)) {
+                std::string format, path;
+                std::cout << "Enter format (csv, jsonl or bin): ";
+                std::cin >> format;
+                std::cout << "Enter output file: ";
+                std::cin >> path;
+                ExportDataStructure(*dataStructure, format, path);
+            }
+            else {
+                std::cout << "Data structure is empty. Load data first.\n";
+            }
+        }
+
+        // exit program and clean memory
+        else if (choice == "4") {
+            ExitProgram();
+            break;  // exit the while loop
+        }
+        else { // handle invalid menu options
+            std::cout << choice << " is not a valid option." << std::endl;
+        }
+    }
+
+    delete dataStructure; // cleanup before exiting the program
+
+    return 0;  // indicate successful program termination
+}
+
+
@@ -1,62 +1,1114 @@
-//=========================================================================
-// Name        : BinarySearchTree.cpp
-// Author      : John St Hilaire
-// Version     : 1.0
-// Last Updated : 2/25/23
-// Description : Menu helper functions for Project 1 for CS300 at SNHU
-//=========================================================================
-
-
-#include "BinarySearchTree.h"  // header for the BinarySearchTree class
-#include <fstream>             // header for file stream operations
-#include <sstream>             // header for string stream operations
-#include <iostream>
-
-// Function to load data from the file into the Binary Search Tree
-bool LoadDataStructure(BinarySearchTree& bst, const std::string& filename) {
-    std::ifstream file(filename); // open the file
-    if (!file.is_open()) {
-        return false; // return false if file can't be opened
-    }
-
-    std::string line;
-    while (getline(file, line)) { // read each line from the file
-        std::stringstream ss(line);
-        std::string courseNumber, title;
-        std::vector<std::string> prerequisites;
-
-        getline(ss, courseNumber, ','); // get the course number
-        getline(ss, title, ','); // get the title
-
-        std::string prerequisite;
-        while (getline(ss, prerequisite, ',')) { // get all prerequisites
-            prerequisites.push_back(prerequisite);
-        }
-
-        Course course(courseNumber, title, prerequisites); // create a course object
-        bst.insert(course); // insert the course into the BST
-    }
-
-    file.close(); // close the file
-    return true; // return true if  successful
-}
-
-// Function to check if the Binary Search Tree is empty
-bool DataStructureIsEmpty(const BinarySearchTree& bst) {
-    return bst.isEmpty(); // call the isEmpty method of BST
-}
-
-// Function to print an alphanumerically ordered list of all courses
-void PrintCourseList(const BinarySearchTree& bst) {
-    bst.printAllCourses(); // call the printAllCourses method of BST
-}
-
-// Function to find and print the title and prerequisites of a course given its ID
-void PrintCourseInformation(const BinarySearchTree& bst, const std::string& courseID) {
-    bst.printCourse(courseID); // call the printcourse method of bst with the given course id
-}
-
-// Function to cleanly exit the program
-void ExitProgram() {
-    std::cout << "Exiting program.\n"; // print exiting message
-}
+//=========================================================================
+// Name        : BinarySearchTree.cpp
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 2/25/23
+// Description : Menu helper functions for Project 1 for CS300 at SNHU
+//=========================================================================
+
+
+#include "menuFunctions.h"     // header for the menu helper functions
+#include "MappedFile.h"        // header for the memory-mapped file wrapper
+#include "CourseParser.h"      // header for splitting rows and merging parsed chunks
+#include "SharedCatalog.h"     // header for publishing catalog versions to reader threads
+#include "CourseClient.h"      // header for querying a running course server
+#include "SemesterPlanner.h"   // header for planning terms toward target courses
+#include "CourseExporter.h"    // header for streaming the catalog out
+#include "CaseFold.h"          // header for folding lookups on the compiled catalog
+#include "AllocationCounter.h" // header for counting allocations in instrumented builds
+#include <fstream>             // header for file stream operations
+#include <sstream>             // header for string stream operations
+#include <iostream>
+#include <chrono>              // header for timing the load
+#include <string_view>         // header for splitting fields in place
+#include <algorithm>           // header for sorting and merging parsed rows
+#include <functional>          // header for std::ref
+#include <thread>              // header for the parallel parse
+#include <atomic>              // header for stopping the stress test threads
+#include <memory>              // header for handing new versions to the shared catalog
+#include <cstdlib>             // header for reading numbers out of the students file
+#include <cctype>              // header for lowercasing the benchmark queries
+
+// Load the file with getline, building a stringstream per line and a string per field.
+static bool LoadStream(BinarySearchTree& bst, const std::string& filename, std::size_t& rows) {
+    std::ifstream file(filename); // open the file
+    if (!file.is_open()) {
+        return false; // return false if file can't be opened
+    }
+
+    std::string line;
+    while (getline(file, line)) { // read each line from the file
+        std::stringstream ss(line);
+        std::string courseNumber, title;
+        std::vector<std::string> prerequisites;
+
+        getline(ss, courseNumber, ','); // get the course number
+        getline(ss, title, ','); // get the title
+
+        std::string prerequisite;
+        while (getline(ss, prerequisite, ',')) { // get all prerequisites
+            prerequisites.push_back(prerequisite);
+        }
+
+        bst.insert(Course(std::move(courseNumber), std::move(title), std::move(prerequisites))); // create a course object and insert it into the BST
+        ++rows;
+    }
+
+    file.close(); // close the file
+    return true; // return true if  successful
+}
+
+// Load the file through a memory map, splitting lines and fields in place as string_views.
+// Bytes are only copied once, into the tree's string pool.
+static bool LoadMapped(BinarySearchTree& bst, const std::string& filename, std::size_t& rows) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false; // return false if file can't be mapped
+    }
+
+    std::string_view text = file.view();
+    std::vector<std::string_view> prerequisites; // reused between rows to keep its capacity
+    while (!text.empty()) {
+        std::string_view line = NextLine(text);
+        if (line.empty()) {
+            continue; // skip blank lines
+        }
+
+        std::string_view courseNumber, title;
+        prerequisites.clear();
+        SplitRow(line, courseNumber, title, prerequisites);
+        bst.emplace(courseNumber, title, prerequisites); // the fields go straight from the mapping into the tree's pool
+        ++rows;
+    }
+    return true; // return true if successful
+}
+
+// Load the file through a memory map on every core. The file is cut into newline-aligned chunks,
+// each thread parses and sorts its own, the sorted runs are merged pairwise, and the tree is built
+// bottom-up from the merged rows in linear time.
+static bool LoadParallel(BinarySearchTree& bst, const std::string& filename, std::size_t& rows) {
+    static const std::size_t MIN_CHUNK = 1 << 16; // below this a thread costs more than it saves
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false; // return false if file can't be mapped
+    }
+
+    // cut the file into one chunk per core
+    std::string_view text = file.view();
+    std::size_t threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min(threads, text.size() / MIN_CHUNK));
+    std::vector<std::string_view> slices = SliceText(text, threads);
+
+    // parse every chunk on its own thread, the calling thread takes the first one
+    std::vector<ParsedChunk> chunks(slices.size());
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < slices.size(); ++i) {
+        workers.emplace_back(ParseChunk, slices[i], std::ref(chunks[i]));
+    }
+    if (!slices.empty()) ParseChunk(slices[0], chunks[0]);
+    for (std::thread& worker : workers) worker.join();
+
+    std::vector<CourseFields> sorted = MergeChunks(chunks, rows);
+    if (!bst.buildSorted(sorted)) { // the tree already has courses, so add the rows one at a time
+        std::vector<std::string_view> prerequisites;
+        for (const CourseFields& row : sorted) {
+            prerequisites.assign(row.prerequisites, row.prerequisites + row.prerequisiteCount);
+            bst.emplace(row.courseNumber, row.title, prerequisites);
+        }
+    }
+    return true; // return true if successful
+}
+
+// Check if the snapshot next to the csv file was built from the csv as it is now: the size and
+// modification time recorded in the snapshot have to match exactly. A csv replaced by an older
+// file or edited while it was loading doesn't match, where comparing timestamps would pass.
+static bool SnapshotIsCurrent(const std::string& filename, const std::string& snapshotName) {
+    SnapshotSource csv, recorded;
+    return SnapshotSource::of(filename, csv) && FrozenCatalog::sourceOf(snapshotName, recorded) && csv == recorded;
+}
+
+// Write the snapshot of a tree loaded from source, unless the csv changed while it was being read.
+static void SaveSnapshot(const BinarySearchTree& bst, const std::string& filename, const SnapshotSource& source) {
+    std::string snapshotName = filename + ".snap";
+    SnapshotSource now;
+    if (!SnapshotSource::of(filename, now) || now != source) {
+        std::cout << filename << " changed while loading, " << snapshotName << " not written" << std::endl;
+    }
+    else if (!bst.saveSnapshot(snapshotName, source)) {
+        std::cout << "Could not write " << snapshotName << std::endl;
+    }
+}
+
+// Function to load data from the file into the Binary Search Tree
+// When the tree is empty and filename + ".snap" was built from the csv as it is now, the snapshot is mapped
+// instead of parsing the csv. After parsing into an empty tree the snapshot is written again for next time.
+bool LoadDataStructure(BinarySearchTree& bst, const std::string& filename, LoadMode mode, bool useSnapshot) {
+    std::size_t rows = 0;
+    auto start = std::chrono::steady_clock::now(); // time the load so the modes can be compared
+    std::string snapshotName = filename + ".snap";
+    bool wasEmpty = bst.isEmpty();
+
+    // the csv's size and time are taken before it is read, so a change during the load shows
+    SnapshotSource source;
+    bool snapshotUsable = useSnapshot && wasEmpty && SnapshotSource::of(filename, source);
+
+    bool success;
+    bool fromSnapshot = false;
+    if (snapshotUsable && bst.loadSnapshot(snapshotName, source)) {
+        success = true;
+        fromSnapshot = true;
+        rows = bst.courseCount();
+    }
+    else {
+        switch (mode) {
+        case LoadMode::Stream:
+            success = LoadStream(bst, filename, rows);
+            break;
+        case LoadMode::Mapped:
+            success = LoadMapped(bst, filename, rows);
+            break;
+        default:
+            success = LoadParallel(bst, filename, rows);
+            break;
+        }
+    }
+    if (!success) {
+        return false;
+    }
+    if (!fromSnapshot) {
+        bst.compact(); // lay the loaded nodes out in tree order
+        bst.freeze(); // the planner only reads from here on, so compile the flat lookup array
+        if (snapshotUsable) { // a merged load doesn't match the csv alone
+            SaveSnapshot(bst, filename, source);
+        }
+    }
+
+    // report throughput in rows per second
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Loaded " << rows << " rows in " << seconds << " seconds";
+    if (seconds > 0.0) {
+        std::cout << " (" << static_cast<std::size_t>(rows / seconds) << " rows/sec)";
+    }
+    if (fromSnapshot) {
+        std::cout << " [snapshot]" << std::endl;
+    }
+    else {
+        std::cout << (mode == LoadMode::Stream ? " [stream]" : mode == LoadMode::Mapped ? " [mapped]" : " [parallel]") << std::endl;
+    }
+    return true;
+}
+
+// Function to start loading a file at launch without holding up the menu
+// A current snapshot maps in no time, so it is loaded right away instead and the loader isn't used.
+bool StartBackgroundLoad(BinarySearchTree& bst, BackgroundLoader& loader, const std::string& filename, bool useSnapshot) {
+    if (useSnapshot && SnapshotIsCurrent(filename, filename + ".snap")) {
+        return LoadDataStructure(bst, filename, LoadMode::Parallel, useSnapshot);
+    }
+    if (!loader.start(bst, filename)) {
+        return false;
+    }
+    std::cout << "Loading " << filename << " in the background, courses can be looked up meanwhile." << std::endl;
+    return true;
+}
+
+// Function to wait for a background load, then report it the way LoadDataStructure does,
+// with how long the first lookup had to wait since launch
+bool FinishBackgroundLoad(BinarySearchTree& bst, BackgroundLoader& loader, const std::string& filename, bool useSnapshot) {
+    if (!loader.finish()) {
+        return false;
+    }
+    if (useSnapshot) {
+        SaveSnapshot(bst, filename, loader.source());
+    }
+    std::size_t rows = loader.rows();
+    double seconds = loader.loadSeconds();
+    std::cout << "Loaded " << rows << " rows in " << seconds << " seconds";
+    if (seconds > 0.0) {
+        std::cout << " (" << static_cast<std::size_t>(rows / seconds) << " rows/sec)";
+    }
+    std::cout << " [background]";
+    if (loader.firstAnswer() >= 0.0) {
+        std::cout << ", first lookup answered after " << loader.firstAnswer() << " seconds";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+// Function to bring the tree up to date with a changed file, applying only the rows that differ
+bool ReloadDataStructure(BinarySearchTree& bst, CatalogReloader& reloader, const std::string& filename) {
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false; // return false if file can't be mapped
+    }
+
+    reloader.begin(bst);
+    std::string_view text = file.view();
+    std::vector<std::string_view> prerequisites; // reused between rows to keep its capacity
+    std::size_t rows = 0;
+    while (!text.empty()) {
+        std::string_view line = NextLine(text);
+        if (line.empty()) {
+            continue; // skip blank lines
+        }
+
+        std::string_view courseNumber, title;
+        prerequisites.clear();
+        SplitRow(line, courseNumber, title, prerequisites);
+        reloader.apply(bst, courseNumber, title, prerequisites);
+        ++rows;
+    }
+    reloader.finish(bst);
+
+    const ReloadChanges& changes = reloader.changes();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Reloaded " << rows << " rows in " << seconds << " seconds: " << changes.inserted << " added, "
+        << changes.updated << " updated, " << changes.deleted << " removed" << std::endl;
+    return true;
+}
+
+// Function to check if the Binary Search Tree is empty
+bool DataStructureIsEmpty(const BinarySearchTree& bst) {
+    return bst.isEmpty(); // call the isEmpty method of BST
+}
+
+// Function to print an alphanumerically ordered list of all courses
+void PrintCourseList(const BinarySearchTree& bst) {
+    bst.printAllCourses(); // call the printAllCourses method of BST
+}
+
+// Function to find and print the title and prerequisites of a course given its ID
+void PrintCourseInformation(const BinarySearchTree& bst, const std::string& courseID) {
+    bst.printCourse(courseID); // call the printcourse method of bst with the given course id
+}
+
+// Function to print a course while the file is still loading in the background, in the same format
+// printCourse uses. It answers as soon as the part of the file listing the course has been parsed.
+void PrintCourseWhileLoading(BackgroundLoader& loader, const std::string& courseID) {
+    CourseFields course;
+    if (!loader.find(courseID, course)) {
+        std::cout << "Course not found." << std::endl;
+        return;
+    }
+    std::cout.flush(); // anything already printed goes first
+    ExportBuffer out(stdout, 4096);
+    WriteCourseDetails(out, course);
+}
+
+// Function to export the catalog in a format named "csv", "jsonl" or "bin" to a file, or with path "-" to
+// standard output for piping into another program. The report goes to standard error then, so it stays
+// out of the exported data.
+bool ExportDataStructure(const BinarySearchTree& bst, const std::string& formatName, const std::string& path) {
+    std::ostream& report = path == "-" ? std::cerr : std::cout;
+    ExportFormat format;
+    if (!ParseExportFormat(formatName, format)) {
+        report << formatName << " is not an export format, use csv, jsonl or bin." << std::endl;
+        return false;
+    }
+    std::size_t courses = 0;
+    std::size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    if (!ExportCatalog(bst, format, path, courses, bytes)) {
+        report << "Could not write " << path << std::endl;
+        return false;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double megabytes = bytes / (1024.0 * 1024.0);
+    report << "Exported " << courses << " courses (" << megabytes << " MiB) in " << seconds << " seconds ("
+        << (seconds > 0.0 ? megabytes / seconds : 0.0) << " MiB/sec)" << std::endl;
+    return true;
+}
+
+// Function to print every course whose number starts with a prefix, e.g. "CSCI3" for the 300 level
+void PrintCoursesWithPrefix(const BinarySearchTree& bst, const std::string& prefix) {
+    CourseRange courses = bst.withPrefix(prefix); // both ends are found in O(log n), the courses are read as they print
+    if (courses.empty()) {
+        std::cout << "No courses start with " << prefix << "." << std::endl;
+        return;
+    }
+    std::cout << std::endl;
+    std::cout.flush(); // the list goes out in one block after what was already printed
+    ExportBuffer out(stdout);
+    for (const CourseCursor& course : courses) {
+        WriteListingLine(out, course);
+    }
+    out.flush();
+    std::cout << std::endl;
+}
+
+// Function to print every course of a compiled catalog, in the format printAllCourses uses
+void PrintCourseList(const StaticCatalog& catalog) {
+    std::cout.flush(); // anything already printed goes first
+    ExportBuffer out(stdout);
+    out.put('\n');
+    for (std::size_t i = 0; i < catalog.size(); ++i) {
+        WriteListingLine(out, catalog.course(i));
+    }
+    out.put('\n');
+}
+
+// Function to print one course of a compiled catalog, in the format printCourse uses
+void PrintCourseInformation(const StaticCatalog& catalog, const std::string& courseID) {
+    std::uint32_t found = catalog.find(FoldedKey(courseID).view()); // the catalog's numbers are stored folded
+    if (found == StaticCatalog::NOT_FOUND) {
+        std::cout << "Course not found." << std::endl;
+        return;
+    }
+    std::cout.flush(); // anything already printed goes first
+    ExportBuffer out(stdout, 4096);
+    WriteCourseDetails(out, catalog, catalog.course(found));
+}
+
+// Function to print the courses of a compiled catalog whose number starts with a prefix
+void PrintCoursesWithPrefix(const StaticCatalog& catalog, const std::string& prefix) {
+    FoldedKey key(prefix);
+    std::size_t first = catalog.lowerBound(key.view());
+    std::size_t last = first;
+    while (last < catalog.size() && catalog.course(last).number.substr(0, key.view().size()) == key.view()) {
+        ++last;
+    }
+    if (first == last) {
+        std::cout << "No courses start with " << prefix << "." << std::endl;
+        return;
+    }
+    std::cout << std::endl;
+    std::cout.flush(); // the list goes out in one block after what was already printed
+    ExportBuffer out(stdout);
+    for (std::size_t i = first; i < last; ++i) {
+        WriteListingLine(out, catalog.course(i));
+    }
+    out.flush();
+    std::cout << std::endl;
+}
+
+// Split a list of course numbers separated by spaces or commas.
+static std::vector<std::string> SplitCourseList(std::string_view text) {
+    std::vector<std::string> numbers;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find_first_of(" ,", start);
+        if (end == std::string_view::npos) end = text.size();
+        if (end > start) numbers.emplace_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return numbers;
+}
+
+// Write the terms of a plan on one line each, with what couldn't be planned.
+static void PrintPlanTerms(const PrerequisiteGraph& graph, const SemesterPlan& plan) {
+    for (std::size_t term = 0; term < plan.terms.size(); ++term) {
+        std::cout << "Term " << term + 1 << ":";
+        for (std::uint32_t course : plan.terms[term]) {
+            std::cout << " " << graph.nameOf(course);
+        }
+        std::cout << std::endl;
+    }
+    if (plan.terms.empty()) {
+        std::cout << "Nothing left to take." << std::endl;
+    }
+    else if (plan.isShortest()) {
+        std::cout << plan.terms.size() << " terms, the fewest possible." << std::endl;
+    }
+    else {
+        std::cout << plan.terms.size() << " terms, no plan can take fewer than " << plan.lowerBound << "." << std::endl;
+    }
+    if (!plan.blocked.empty()) {
+        std::cout << "Can't be planned (not offered, or on a prerequisite cycle):";
+        for (std::uint32_t course : plan.blocked) {
+            std::cout << " " << graph.nameOf(course);
+        }
+        std::cout << std::endl;
+    }
+    for (const std::string& number : plan.unknown) {
+        std::cout << number << " is not in the catalog." << std::endl;
+    }
+}
+
+// Function to plan the terms one student needs to take every target course, at most perTerm courses a term
+void PrintSemesterPlan(const PrerequisiteGraph& graph, const std::string& completed, const std::string& targets, std::size_t perTerm) {
+    PlanRequest request = { SplitCourseList(completed), SplitCourseList(targets), perTerm };
+    SemesterPlanner planner(graph);
+    std::cout << std::endl;
+    PrintPlanTerms(graph, planner.plan(request));
+    std::cout << std::endl;
+}
+
+// Function to plan a whole file of students on every core and print one line per student.
+// Each line of the file is: student id,courses per term,target courses,completed courses
+// with the courses in a list separated by spaces. A plan prints as its terms separated by " | ".
+bool PlanStudentBatch(const PrerequisiteGraph& graph, const std::string& studentsFile) {
+    std::ifstream file(studentsFile);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<std::string> ids;
+    std::vector<PlanRequest> requests;
+    std::string line;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string id, perTerm, targets, completed;
+        getline(ss, id, ',');
+        getline(ss, perTerm, ',');
+        getline(ss, targets, ',');
+        getline(ss, completed, ',');
+        ids.push_back(id);
+        requests.push_back({ SplitCourseList(completed), SplitCourseList(targets), static_cast<std::size_t>(std::strtoul(perTerm.c_str(), nullptr, 10)) });
+    }
+
+    SemesterPlanner planner(graph);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SemesterPlan> plans = planner.planAll(requests);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t shortest = 0;
+    std::string out;
+    for (std::size_t i = 0; i < plans.size(); ++i) {
+        const SemesterPlan& plan = plans[i];
+        shortest += plan.isShortest() ? 1 : 0;
+        out += ids[i] + ": " + std::to_string(plan.terms.size()) + " terms";
+        for (const std::vector<std::uint32_t>& term : plan.terms) {
+            out += " |";
+            for (std::uint32_t course : term) {
+                out += " " + graph.nameOf(course);
+            }
+        }
+        if (!plan.blocked.empty() || !plan.unknown.empty()) {
+            out += " | can't plan " + std::to_string(plan.blocked.size() + plan.unknown.size()) + " courses";
+        }
+        out += "\n";
+    }
+    std::cout << out;
+    std::cout << "Planned " << plans.size() << " students in " << seconds << " seconds";
+    if (seconds > 0.0) {
+        std::cout << " (" << static_cast<std::size_t>(plans.size() / seconds) << " plans/sec)";
+    }
+    std::cout << ", " << shortest << " of them in the fewest terms possible" << std::endl;
+    return true;
+}
+
+// Function to print the courses whose titles match every word of a query, best matches first
+void PrintTitleSearch(const BinarySearchTree& bst, const TitleIndex& index, const std::string& query) {
+    std::vector<TitleMatch> matches = index.search(query);
+    if (matches.empty()) {
+        std::cout << "No course titles match " << query << "." << std::endl;
+        return;
+    }
+    std::cout << std::endl;
+    for (const TitleMatch& match : matches) {
+        CourseIterator course = bst.find(match.courseNumber); // the index keeps numbers, the title comes from the tree
+        if (course == bst.end()) {
+            continue; // removed since the index was built
+        }
+        std::cout << match.courseNumber << ", " << course->title() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// Function to time title searches against the loaded catalog and print the latency percentiles.
+// The queries come from the catalog's own titles: whole words, word starts, fragments from the
+// middle of words and two word starts together, the way advisors type them.
+void BenchmarkTitleSearch(const BinarySearchTree& bst, const TitleIndex& index) {
+    static const char* KINDS[] = { "whole word", "word start", "inside word", "two words" };
+    const std::size_t SAMPLE = 2000; // titles the queries are taken from
+
+    std::vector<std::string> queries[4];
+    std::size_t count = bst.courseCount();
+    std::size_t step = count > SAMPLE ? count / SAMPLE : 1;
+    std::size_t i = 0;
+    for (const CourseCursor& course : bst) {
+        if (i++ % step != 0) continue;
+        std::vector<std::string> titleWords; // the title's words of at least 3 bytes
+        std::string_view title = course.title();
+        std::size_t start = 0;
+        while (start < title.size()) {
+            std::size_t end = title.find(' ', start);
+            if (end == std::string_view::npos) end = title.size();
+            if (end - start >= 3) titleWords.emplace_back(title.substr(start, end - start));
+            start = end + 1;
+        }
+        if (titleWords.empty()) continue;
+        const std::string& word = titleWords[i % titleWords.size()];
+        queries[0].push_back(word);
+        queries[1].push_back(word.substr(0, 3));
+        if (word.size() >= 6) queries[2].push_back(word.substr(1, 4));
+        if (titleWords.size() >= 2) queries[3].push_back(titleWords[0].substr(0, 3) + " " + titleWords.back().substr(0, 4));
+    }
+
+    std::cout << "Title index: " << index.courseCount() << " courses, " << index.wordCount() << " distinct words, "
+        << index.memoryBytes() / 1024 << " KiB" << std::endl;
+    for (int kind = 0; kind < 4; ++kind) {
+        if (queries[kind].empty()) continue;
+        for (const std::string& query : queries[kind]) {
+            index.search(query); // one untimed pass, so the timings are for a warm index
+        }
+        std::vector<double> micros;
+        std::size_t results = 0;
+        for (const std::string& query : queries[kind]) {
+            auto start = std::chrono::steady_clock::now();
+            results += index.search(query).size();
+            micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(micros.begin(), micros.end());
+        std::cout << "  " << KINDS[kind] << ": " << micros.size() << " queries, p50 " << micros[micros.size() / 2]
+            << " us, p99 " << micros[micros.size() * 99 / 100] << " us, max " << micros.back() << " us, "
+            << results / micros.size() << " results per query" << std::endl;
+    }
+}
+
+// Function to check that lookups keep going, and at what rate, while the file is reloaded over and over.
+// Reader threads look up sampled course numbers through a SharedCatalog, first with nothing else
+// running, then while another thread builds a new tree from the file and publishes it, back to back.
+// A lookup that misses its course or sees a catalog of the wrong size counts as an error.
+void StressSnapshotReads(const std::string& filename) {
+    const double PHASE_SECONDS = 2.0; // length of each phase
+    const std::size_t SAMPLE = 4096;  // course numbers the readers look up
+
+    // build one version the way a load does, without the messages
+    auto loadVersion = [&filename]() {
+        std::unique_ptr<BinarySearchTree> tree(new BinarySearchTree());
+        std::size_t rows = 0;
+        if (!LoadParallel(*tree, filename, rows)) {
+            tree.reset();
+            return tree;
+        }
+        tree->compact();
+        tree->freeze();
+        return tree;
+    };
+
+    std::unique_ptr<BinarySearchTree> first = loadVersion();
+    if (!first || first->isEmpty()) {
+        std::cout << "Could not load " << filename << " for the stress test." << std::endl;
+        return;
+    }
+    std::size_t expectedCount = first->courseCount();
+    std::vector<std::string> numbers;
+    std::size_t step = expectedCount > SAMPLE ? expectedCount / SAMPLE : 1;
+    std::size_t i = 0;
+    for (const CourseCursor& course : *first) {
+        if (i++ % step == 0) numbers.emplace_back(course.number());
+    }
+
+    SharedCatalog catalog;
+    catalog.publish(std::move(first));
+    std::size_t readerCount = std::max(2u, std::thread::hardware_concurrency()) - 1; // one core is left for the reloads
+
+    // run the readers for one phase, optionally reloading the whole time, and report the lookup rate
+    auto runPhase = [&](bool reloading) {
+        std::atomic<bool> stop(false);
+        std::atomic<std::size_t> lookups(0);
+        std::atomic<std::size_t> errors(0);
+        std::size_t reloads = 0;
+
+        std::vector<std::thread> readers;
+        for (std::size_t t = 0; t < readerCount; ++t) {
+            readers.emplace_back([&, t]() {
+                SharedCatalog::Reader reader(catalog);
+                std::uint64_t random = 0x9E3779B97F4A7C15ULL * (t + 1); // xorshift, a different walk per thread
+                std::size_t done = 0;
+                std::size_t failed = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int batch = 0; batch < 256; ++batch) {
+                        random ^= random << 13;
+                        random ^= random >> 7;
+                        random ^= random << 17;
+                        const std::string& number = numbers[random % numbers.size()];
+                        SharedCatalog::ReadGuard courses = reader.read();
+                        CourseIterator course = courses->find(number);
+                        if (course == courses->end() || course->number() != number || courses->courseCount() != expectedCount) {
+                            ++failed;
+                        }
+                        ++done;
+                    }
+                }
+                lookups += done;
+                errors += failed;
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::duration<double>(PHASE_SECONDS);
+        if (reloading) { // this thread reloads until the phase is over
+            while (std::chrono::steady_clock::now() < deadline) {
+                std::unique_ptr<BinarySearchTree> tree = loadVersion();
+                if (!tree) break;
+                catalog.publish(std::move(tree));
+                ++reloads;
+            }
+        }
+        else {
+            std::this_thread::sleep_until(deadline);
+        }
+        stop = true;
+        for (std::thread& reader : readers) reader.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double rate = lookups / seconds;
+
+        std::cout << "  " << (reloading ? "during reloads" : "no reloads") << ": " << static_cast<std::size_t>(rate)
+            << " lookups/sec, " << errors.load() << " errors";
+        if (reloading) {
+            std::cout << ", " << reloads << " versions published";
+        }
+        std::cout << std::endl;
+        return rate;
+    };
+
+    std::cout << "Snapshot reads: " << readerCount << " reader threads, " << expectedCount << " courses" << std::endl;
+    double quiet = runPhase(false);
+    double busy = runPhase(true);
+    catalog.reclaim(); // every reader is gone, so every replaced version can go
+    std::cout << "  lookups kept " << static_cast<int>(quiet > 0.0 ? 100.0 * busy / quiet : 0.0) << "% of their rate, "
+        << catalog.freedTotal() << " old versions freed, " << catalog.retiredCount() << " still held" << std::endl;
+}
+
+// Function to load a running course server from several client threads and report the query rate
+// and round trip latency. The queries are mostly single lookups, with some prerequisite and prefix
+// queries mixed in, on course numbers sampled from the server's own LIST. Each client first sends
+// one query per round trip, then a batch of them per write.
+void BenchmarkCourseServer(const std::string& socketPath, std::size_t clients) {
+    const double PHASE_SECONDS = 2.0; // length of each phase
+    const std::size_t SAMPLE = 4096;  // course numbers the queries use
+    static const std::size_t BATCHES[] = { 1, 32 }; // queries per round trip, one phase each
+
+    CourseClient sampler;
+    std::vector<std::string> lines;
+    std::size_t count = 0;
+    if (!sampler.connect(socketPath) || !sampler.send("LIST\n") || !sampler.readAnswer(count, &lines) || lines.empty()) {
+        std::cout << "Could not list the courses of the server at " << socketPath << std::endl;
+        return;
+    }
+    sampler.close();
+    std::vector<std::string> numbers;
+    std::size_t step = lines.size() > SAMPLE ? lines.size() / SAMPLE : 1;
+    for (std::size_t i = 0; i < lines.size(); i += step) {
+        numbers.push_back(lines[i].substr(0, lines[i].find(',')));
+    }
+    lines.clear();
+
+    std::cout << "Course server at " << socketPath << ": " << count << " courses, " << clients << " client threads" << std::endl;
+    for (std::size_t batch : BATCHES) {
+        std::atomic<bool> stop(false);
+        std::atomic<std::size_t> failures(0);
+        std::vector<std::vector<double>> micros(clients); // round trip times per client
+        std::vector<std::size_t> queries(clients, 0);
+
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < clients; ++t) {
+            threads.emplace_back([&, t]() {
+                CourseClient client;
+                if (!client.connect(socketPath)) {
+                    ++failures;
+                    return;
+                }
+                std::uint64_t random = 0x9E3779B97F4A7C15ULL * (t + 1); // xorshift, a different mix per thread
+                std::string requests;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    requests.clear();
+                    for (std::size_t q = 0; q < batch; ++q) {
+                        random ^= random << 13;
+                        random ^= random >> 7;
+                        random ^= random << 17;
+                        const std::string& number = numbers[(random >> 8) % numbers.size()];
+                        switch (random % 10) {
+                        case 0: // a tenth are prerequisite chains
+                            requests += "PREREQS " + number + "\n";
+                            break;
+                        case 1: // a tenth list the neighbours sharing all but the last character
+                            requests += "PREFIX " + number.substr(0, number.size() - 1) + "\n";
+                            break;
+                        default:
+                            requests += "FIND " + number + "\n";
+                            break;
+                        }
+                    }
+                    auto start = std::chrono::steady_clock::now();
+                    bool ok = client.send(requests);
+                    std::size_t courses;
+                    for (std::size_t q = 0; q < batch && ok; ++q) {
+                        ok = client.readAnswer(courses);
+                    }
+                    if (!ok) {
+                        ++failures;
+                        return;
+                    }
+                    micros[t].push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+                    queries[t] += batch;
+                }
+            });
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::duration<double>(PHASE_SECONDS));
+        stop = true;
+        for (std::thread& thread : threads) thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<double> all;
+        std::size_t total = 0;
+        for (std::size_t t = 0; t < clients; ++t) {
+            all.insert(all.end(), micros[t].begin(), micros[t].end());
+            total += queries[t];
+        }
+        if (all.empty()) {
+            std::cout << "  " << batch << " per round trip: no answers, " << failures.load() << " failed clients" << std::endl;
+            continue;
+        }
+        std::sort(all.begin(), all.end());
+        std::cout << "  " << batch << " per round trip: " << static_cast<std::size_t>(total / seconds) << " queries/sec, round trip p50 "
+            << all[all.size() / 2] << " us, p99 " << all[all.size() * 99 / 100] << " us, " << failures.load() << " failed clients" << std::endl;
+    }
+}
+
+// Generate about n sorted, distinct course numbers for the benchmarks: a four letter department and
+// a three digit or longer course number, so like a real catalog's they share long prefixes.
+static std::vector<std::string> GenerateCourseNumbers(std::size_t n) {
+    std::size_t departments = std::max<std::size_t>(26, n / 400);
+    std::vector<std::string> numbers;
+    numbers.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t code = (i % departments) * 7919 % (26 * 26 * 26 * 26); // spread the departments over the alphabet
+        std::string number(4, 'A');
+        for (std::size_t letter = 4; letter-- > 0;) {
+            number[letter] = static_cast<char>('A' + code % 26);
+            code /= 26;
+        }
+        numbers.push_back(number + std::to_string(100 + i / departments));
+    }
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+    return numbers;
+}
+
+// Function to compare the ways a course number can be looked up, on generated catalogs of 10^4
+// courses and up by powers of ten to maxKeys: the red-black tree's descent, the radix index and the
+// frozen array. A tenth of the lookups are for numbers that aren't there. The in-order walks behind
+// printAllCourses are timed as well.
+void BenchmarkCourseIndexes(std::size_t maxKeys) {
+    const std::size_t LOOKUPS = 1000000;
+
+    for (std::size_t n = 10000; n <= maxKeys; n *= 10) {
+        std::vector<std::string> numbers = GenerateCourseNumbers(n);
+
+        BinarySearchTree tree;
+        {
+            std::vector<CourseFields> rows;
+            rows.reserve(numbers.size());
+            for (const std::string& number : numbers) {
+                rows.push_back({ number, "Generated Course", nullptr, 0 });
+            }
+            tree.buildSorted(rows);
+        }
+
+        std::vector<std::string> queries;
+        queries.reserve(LOOKUPS);
+        std::uint64_t random = 0x9E3779B97F4A7C15ULL; // xorshift, the same queries for every path
+        for (std::size_t i = 0; i < LOOKUPS; ++i) {
+            random ^= random << 13;
+            random ^= random >> 7;
+            random ^= random << 17;
+            queries.push_back(numbers[random % numbers.size()]);
+            if (i % 10 == 0) queries.back() += "X"; // a miss that shares the whole prefix
+        }
+
+        // one pass of lookups, in nanoseconds per lookup, after an untimed pass so the timings are for warm caches
+        auto timeLookups = [&]() {
+            std::size_t found = 0;
+            for (const std::string& query : queries) {
+                found += tree.find(query) != tree.end();
+            }
+            found = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (const std::string& query : queries) {
+                found += tree.find(query) != tree.end();
+            }
+            double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            if (found != LOOKUPS - (LOOKUPS + 9) / 10) {
+                std::cout << "  wrong number of courses found: " << found << std::endl;
+            }
+            return nanos / LOOKUPS;
+        };
+
+        double treeLookup = timeLookups();
+        std::size_t walked = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const CourseCursor& course : tree) walked += course.number().size();
+        double treeWalk = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numbers.size();
+
+        start = std::chrono::steady_clock::now();
+        tree.useRadixIndex(true);
+        double radixBuild = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double radixLookup = timeLookups();
+        start = std::chrono::steady_clock::now();
+        tree.radixIndex().forEachInOrder([&](TreeNode* node) { walked -= tree.numberOf(node->course).size(); });
+        double radixWalk = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numbers.size();
+        std::size_t radixBytes = tree.radixIndex().memoryBytes();
+        tree.useRadixIndex(false);
+
+        tree.freeze();
+        double frozenLookup = timeLookups();
+
+        std::cout << numbers.size() << " courses: lookups tree " << treeLookup << " ns, radix " << radixLookup
+            << " ns, frozen " << frozenLookup << " ns; sorted walk tree " << treeWalk << " ns, radix " << radixWalk
+            << " ns per course; radix index built in " << radixBuild << " s, " << radixBytes / (1024 * 1024) << " MiB";
+        if (walked != 0) {
+            std::cout << " (the walks disagree)";
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Function to time the prerequisite graph on a generated catalog of n courses where every course lists
+// 0 to 3 prerequisites among the 200 courses before it, so the closures run deep. Queries are timed on
+// vertices asked about for the first time and again on the same vertices, once their rows are kept.
+void BenchmarkPrerequisiteGraph(std::size_t courses) {
+    const std::size_t QUERIES = 2000;
+    const std::size_t WINDOW = 200;
+
+    std::vector<std::string> numbers;
+    numbers.reserve(courses);
+    for (std::size_t i = 0; i < courses; ++i) {
+        std::string digits = std::to_string(i);
+        numbers.push_back("C" + std::string(digits.size() < 7 ? 7 - digits.size() : 0, '0') + digits); // sorted as generated
+    }
+    std::uint64_t random = 0x9E3779B97F4A7C15ULL; // xorshift
+    auto next = [&random]() {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return random;
+    };
+    std::vector<std::size_t> prereqFirst(courses + 1, 0);
+    std::vector<std::string_view> prerequisites;
+    for (std::size_t i = 0; i < courses; ++i) {
+        std::size_t count = i == 0 ? 0 : next() % 4;
+        std::size_t lowest = i > WINDOW ? i - WINDOW : 0;
+        for (std::size_t p = 0; p < count; ++p) {
+            prerequisites.push_back(numbers[lowest + next() % (i - lowest)]);
+        }
+        prereqFirst[i + 1] = prerequisites.size();
+    }
+    BinarySearchTree tree;
+    {
+        std::vector<CourseFields> rows;
+        rows.reserve(courses);
+        for (std::size_t i = 0; i < courses; ++i) {
+            rows.push_back({ numbers[i], "Generated Course", prerequisites.data() + prereqFirst[i], prereqFirst[i + 1] - prereqFirst[i] });
+        }
+        tree.buildSorted(rows);
+    }
+
+    PrerequisiteGraph graph;
+    auto start = std::chrono::steady_clock::now();
+    graph.build(tree);
+    double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << graph.size() << " courses, " << prerequisites.size() << " prerequisites: graph built in " << buildSeconds * 1000.0
+        << " ms, closure rows " << (graph.hasClosure() ? "built with it" : "filled on first query") << std::endl;
+    if (graph.size() == 0) return;
+
+    std::vector<std::size_t> vertices(QUERIES);
+    for (std::size_t& vertex : vertices) vertex = next() % graph.size();
+
+    // microseconds per query over the vertices, and a checksum of the answers so both passes can be compared
+    auto timeQueries = [&](auto query, std::size_t& answers) {
+        answers = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < QUERIES; ++i) {
+            answers += query(vertices[i], vertices[(i + 1) % QUERIES]);
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / QUERIES;
+    };
+    auto dependsOn = [&graph](std::size_t course, std::size_t other) { return static_cast<std::size_t>(graph.dependsOn(course, other)); };
+    auto allPrerequisites = [&graph](std::size_t course, std::size_t) { return graph.allPrerequisites(course).size(); };
+
+    std::size_t firstAnswers, againAnswers, firstCount, againCount;
+    double dependsFirst = timeQueries(dependsOn, firstAnswers);
+    double dependsAgain = timeQueries(dependsOn, againAnswers);
+    double prerequisitesFirst = timeQueries(allPrerequisites, firstCount);
+    double prerequisitesAgain = timeQueries(allPrerequisites, againCount);
+    std::cout << "  dependsOn " << dependsFirst << " us first, " << dependsAgain << " us again; allPrerequisites " << prerequisitesFirst
+        << " us first, " << prerequisitesAgain << " us again, " << firstCount / QUERIES << " courses each on average; closure rows "
+        << graph.closureBytes() / (1024 * 1024) << " MiB" << std::endl;
+    if (firstAnswers != againAnswers || firstCount != againCount) {
+        std::cout << "  the kept rows disagree with the walks" << std::endl;
+    }
+}
+
+// Function to time case-insensitive lookups and count the heap allocations each one makes, on catalogs
+// of the given size with 7 and 20 character course numbers. The queries are lowercase, so every one
+// is folded. Allocations are only counted in builds with COURSE_COUNT_ALLOCATIONS defined.
+void BenchmarkLookupAllocations(std::size_t courses) {
+    const std::size_t LOOKUPS = 1000000;
+
+    for (std::size_t length : { std::size_t(7), std::size_t(20) }) {
+        std::vector<std::string> numbers;
+        numbers.reserve(courses);
+        for (std::size_t i = 0; i < courses; ++i) { // a four letter department per thousand courses, padded out to length
+            std::string number(length, '0');
+            for (std::size_t letter = 4, code = i / 1000; letter-- > 0; code /= 26) {
+                number[letter] = static_cast<char>('A' + code % 26);
+            }
+            std::string digits = std::to_string(1000 + i % 1000);
+            number.replace(length - 3, 3, digits, 1, 3);
+            numbers.push_back(number);
+        }
+        BinarySearchTree tree;
+        {
+            std::vector<CourseFields> rows;
+            rows.reserve(courses);
+            for (const std::string& number : numbers) {
+                rows.push_back({ number, "Generated Course", nullptr, 0 });
+            }
+            tree.buildSorted(rows);
+        }
+
+        std::vector<std::string> queries;
+        queries.reserve(LOOKUPS);
+        std::uint64_t random = 0x9E3779B97F4A7C15ULL; // xorshift, the same queries for every path
+        for (std::size_t i = 0; i < LOOKUPS; ++i) {
+            random ^= random << 13;
+            random ^= random >> 7;
+            random ^= random << 17;
+            std::string query = numbers[random % numbers.size()];
+            for (char& c : query) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            queries.push_back(std::move(query));
+        }
+
+        // one pass of lookups down the path the tree is set up for
+        auto timeLookups = [&](const char* path) {
+            std::size_t found = 0;
+#ifdef COURSE_COUNT_ALLOCATIONS
+            std::size_t allocationsBefore = HeapAllocations();
+#endif
+            auto start = std::chrono::steady_clock::now();
+            for (const std::string& query : queries) {
+                found += tree.find(query) != tree.end();
+            }
+            double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / LOOKUPS;
+            std::cout << "  " << path << " " << nanos << " ns";
+#ifdef COURSE_COUNT_ALLOCATIONS
+            std::cout << ", " << static_cast<double>(HeapAllocations() - allocationsBefore) / LOOKUPS << " allocations";
+#endif
+            if (found != LOOKUPS) {
+                std::cout << " (found " << found << ")";
+            }
+            std::cout << " per lookup" << std::endl;
+        };
+
+        std::cout << numbers.size() << " courses, " << length << " character numbers:" << std::endl;
+        timeLookups("tree");
+        tree.useRadixIndex(true);
+        timeLookups("radix");
+        tree.useRadixIndex(false);
+        tree.freeze();
+        timeLookups("frozen");
+    }
+#ifndef COURSE_COUNT_ALLOCATIONS
+    std::cout << "Build with COURSE_COUNT_ALLOCATIONS defined to count the allocations per lookup." << std::endl;
+#endif
+}
+
+// Function to time loading and tearing down the tree with its nodes in arena slabs against one
+// allocation per node, on generated catalogs of 10^5 courses and up by powers of ten to maxCourses.
+// The courses are inserted one at a time in a shuffled order, the way the menu merges a file into a
+// loaded tree, and teardown is the tree's destructor.
+void BenchmarkNodeArena(std::size_t maxCourses) {
+    for (std::size_t n = 100000; n <= maxCourses; n *= 10) {
+        std::vector<std::string> numbers = GenerateCourseNumbers(n);
+        std::uint64_t random = 0x9E3779B97F4A7C15ULL; // xorshift, the same order for both
+        for (std::size_t i = numbers.size(); i > 1; --i) {
+            random ^= random << 13;
+            random ^= random >> 7;
+            random ^= random << 17;
+            std::swap(numbers[i - 1], numbers[random % i]);
+        }
+
+        std::cout << numbers.size() << " courses:";
+        const std::vector<std::string_view> noPrerequisites;
+        for (std::size_t nodesPerSlab : { std::size_t(1), SlabArena<TreeNode>::DEFAULT_SLAB_ITEMS }) {
+            BinarySearchTree* tree = new BinarySearchTree(nodesPerSlab);
+            auto start = std::chrono::steady_clock::now();
+            for (const std::string& number : numbers) {
+                tree->emplace(number, "Generated Course", noPrerequisites);
+            }
+            double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::size_t loaded = tree->courseCount();
+            start = std::chrono::steady_clock::now();
+            delete tree;
+            double teardownSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << (nodesPerSlab == 1 ? " per node" : "; arena") << " load " << loadSeconds << " s, teardown "
+                << teardownSeconds * 1000.0 << " ms";
+            if (loaded != numbers.size()) {
+                std::cout << " (" << loaded << " loaded)";
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Function to write a loaded catalog out as a header the kiosk build compiles in, see StaticCatalog.h
+bool GenerateStaticCatalog(const std::string& filename, const std::string& headerPath) {
+    BinarySearchTree bst;
+    if (!LoadDataStructure(bst, filename, LoadMode::Parallel, false)) {
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (!WriteStaticCatalog(bst, filename, headerPath, "KioskCatalog")) {
+        std::cout << "Could not write " << headerPath << std::endl;
+        return false;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Wrote " << bst.courseCount() << " courses to " << headerPath << " in " << seconds << " seconds" << std::endl;
+    return true;
+}
+
+// Function to compare lookups in the compiled catalog with lookups in the tree loaded from the file it
+// was generated from, including what the tree costs before it can answer at all.
+void BenchmarkStaticCatalog(const StaticCatalog& catalog, const std::string& filename) {
+    const std::size_t LOOKUPS = 1000000;
+
+    BinarySearchTree bst;
+    auto start = std::chrono::steady_clock::now();
+    if (!LoadDataStructure(bst, filename, LoadMode::Parallel, false)) {
+        return;
+    }
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<std::string> queries;
+    queries.reserve(LOOKUPS);
+    std::uint64_t random = 0x9E3779B97F4A7C15ULL; // xorshift, the same queries for both
+    for (std::size_t i = 0; i < LOOKUPS; ++i) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        queries.emplace_back(catalog.course(random % catalog.size()).number);
+        if (i % 10 == 0) queries.back() += "X"; // a miss
+    }
+
+    std::size_t treeFound = 0;
+    start = std::chrono::steady_clock::now();
+    for (const std::string& query : queries) {
+        treeFound += bst.find(query) != bst.end();
+    }
+    double treeNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / LOOKUPS;
+
+    std::size_t staticFound = 0;
+    start = std::chrono::steady_clock::now();
+    for (const std::string& query : queries) {
+        staticFound += catalog.find(FoldedKey(query).view()) != StaticCatalog::NOT_FOUND;
+    }
+    double staticNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / LOOKUPS;
+
+    std::cout << catalog.size() << " compiled courses: lookups " << staticNanos << " ns, no load; tree " << treeNanos
+        << " ns after a " << loadSeconds * 1000.0 << " ms load" << std::endl;
+    if (treeFound != staticFound) {
+        std::cout << "  the tree found " << treeFound << " courses and the compiled catalog " << staticFound
+            << ", it is out of date, regenerate it with --generate-catalog" << std::endl;
+    }
+}
+
+// Function to cleanly exit the program
+void ExitProgram() {
+    std::cout << "Exiting program.\n"; // print exiting message
+}
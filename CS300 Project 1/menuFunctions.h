@@ -1,21 +1,56 @@
-//=========================================================================
-// Name        : menuFunctions.h
-// Author      : John St Hilaire
-// Version     : 1.0
-// Last Updated : 2/25/23
-// Description : header file for menu helper functions for Project 1 for CS300 at SNHU
-//=========================================================================
-
-#pragma once
-#ifndef MENUFUNCTIONS_H
-#define MENUFUNCTIONS_H
-
-#include "BinarySearchTree.h"
-
-bool LoadDataStructure(BinarySearchTree& bst, const std::string& filename);
-bool DataStructureIsEmpty(const BinarySearchTree& bst);
-void PrintCourseList(const BinarySearchTree& bst);
-void PrintCourseInformation(const BinarySearchTree& bst, const std::string& courseID);
-void ExitProgram();
-
+//=========================================================================
+// Name        : menuFunctions.h
+// Author      : John St Hilaire
+// Version     : 1.0
+// Last Updated : 2/25/23
+// Description : header file for menu helper functions for Project 1 for CS300 at SNHU
+//=========================================================================
+
+#pragma once
+#ifndef MENUFUNCTIONS_H
+#define MENUFUNCTIONS_H
+
+#include "BinarySearchTree.h"
+#include "CatalogReloader.h"
+#include "TitleIndex.h"
+#include "BackgroundLoader.h"
+#include "PrerequisiteGraph.h"
+#include "StaticCatalog.h"
+
+// how LoadDataStructure reads the csv file
+enum class LoadMode {
+    Stream, // getline + stringstream, one std::string per field
+    Mapped, // memory-mapped file split in place with std::string_view
+    Parallel // mapped file parsed on every core, then the tree is built bottom-up
+};
+
+// useSnapshot reads and writes filename + ".snap", a binary copy of the loaded catalog
+bool LoadDataStructure(BinarySearchTree& bst, const std::string& filename, LoadMode mode = LoadMode::Parallel, bool useSnapshot = true);
+bool StartBackgroundLoad(BinarySearchTree& bst, BackgroundLoader& loader, const std::string& filename, bool useSnapshot = true);
+bool FinishBackgroundLoad(BinarySearchTree& bst, BackgroundLoader& loader, const std::string& filename, bool useSnapshot = true);
+bool ReloadDataStructure(BinarySearchTree& bst, CatalogReloader& reloader, const std::string& filename);
+bool DataStructureIsEmpty(const BinarySearchTree& bst);
+void PrintCourseList(const BinarySearchTree& bst);
+void PrintCourseInformation(const BinarySearchTree& bst, const std::string& courseID);
+void PrintCourseWhileLoading(BackgroundLoader& loader, const std::string& courseID);
+void PrintCoursesWithPrefix(const BinarySearchTree& bst, const std::string& prefix);
+// the same queries answered from a catalog compiled into the program
+void PrintCourseList(const StaticCatalog& catalog);
+void PrintCourseInformation(const StaticCatalog& catalog, const std::string& courseID);
+void PrintCoursesWithPrefix(const StaticCatalog& catalog, const std::string& prefix);
+bool ExportDataStructure(const BinarySearchTree& bst, const std::string& formatName, const std::string& path);
+void PrintSemesterPlan(const PrerequisiteGraph& graph, const std::string& completed, const std::string& targets, std::size_t perTerm);
+bool PlanStudentBatch(const PrerequisiteGraph& graph, const std::string& studentsFile);
+void PrintTitleSearch(const BinarySearchTree& bst, const TitleIndex& index, const std::string& query);
+void BenchmarkTitleSearch(const BinarySearchTree& bst, const TitleIndex& index);
+void StressSnapshotReads(const std::string& filename);
+void BenchmarkCourseServer(const std::string& socketPath, std::size_t clients);
+void BenchmarkCourseIndexes(std::size_t maxKeys);
+void BenchmarkNodeArena(std::size_t maxCourses);
+void BenchmarkLookupAllocations(std::size_t courses);
+void BenchmarkPrerequisiteGraph(std::size_t courses);
+void BenchmarkStaticCatalog(const StaticCatalog& catalog, const std::string& filename);
+bool GenerateStaticCatalog(const std::string& filename, const std::string& headerPath);
+void ExitProgram();
+
 #endif // MENUFUNCTIONS_H
\ No newline at end of file
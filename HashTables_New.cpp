@@ -7,10 +7,28 @@
 //============================================================================
 
 #include <algorithm>
+#include <atomic> // for the concurrent benchmark
+#include <chrono> // for the table benchmark
 #include <climits>
+#include <cmath> // pow
+#include <cstring> // memcpy
+#include <cstdint>
 #include <iostream>
+#include <memory> // unique_ptr for the node slabs
+#include <mutex>
+#include <shared_mutex> // for the concurrent table
 #include <string> // atoi
+#include <thread>
 #include <time.h>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_SSE2
+#include <emmintrin.h> // for the SSE2 intrinsics
+#endif
+#ifdef _MSC_VER
+#include <intrin.h> // for _BitScanForward and _umul128
+#endif
 
 #include "CSVparser.hpp"
 
@@ -36,6 +54,116 @@ struct Bid {
     }
 };
 
+//============================================================================
+// Bid id hash policies
+//============================================================================
+
+/**
+ * Multiply two 64-bit numbers into a 128-bit product,
+ * left as its low half in a and its high half in b.
+ */
+static inline void multiply128(uint64_t& a, uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    // four 32-bit products, for targets without a 64x64 multiply
+    uint64_t aHigh = a >> 32, aLow = static_cast<uint32_t>(a);
+    uint64_t bHigh = b >> 32, bLow = static_cast<uint32_t>(b);
+    uint64_t high = aHigh * bHigh, middle1 = aHigh * bLow, middle2 = aLow * bHigh, low = aLow * bLow;
+    uint64_t cross = (low >> 32) + static_cast<uint32_t>(middle1) + static_cast<uint32_t>(middle2);
+    a = (cross << 32) | static_cast<uint32_t>(low);
+    b = high + (middle1 >> 32) + (middle2 >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * Fold the 128-bit product of two numbers into 64 bits
+ */
+static inline uint64_t multiplyFold(uint64_t a, uint64_t b) {
+    multiply128(a, b);
+    return a ^ b;
+}
+
+/**
+ * Read 8 or 4 bytes of an id as a little-endian number
+ */
+static inline uint64_t readBytes8(const char* bytes) {
+    uint64_t value;
+    memcpy(&value, bytes, 8);
+    return value;
+}
+static inline uint64_t readBytes4(const char* bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, 4);
+    return value;
+}
+
+/**
+ * wyhash: reads the id 4 or 8 bytes at a time and mixes them with
+ * 128-bit multiplies, so an id of up to 16 bytes costs two
+ * multiplies. Good in every bit, which open addressing needs.
+ */
+struct WyHash {
+    static uint64_t hash(const string& bidId) {
+        static const uint64_t SECRET[4] = { 0xA0761D6478BD642FULL, 0xE7037ED1A0B428DBULL, 0x8EBC6AF09C88C6E3ULL, 0x589965CC75374CC3ULL };
+        const char* bytes = bidId.data();
+        size_t length = bidId.size();
+        uint64_t seed = multiplyFold(SECRET[0], SECRET[1]);
+        uint64_t a = 0, b = 0;
+        if (length <= 16) {
+            if (length >= 4) { // first and last 4 bytes, and 4 from the middle of each half
+                size_t middle = (length >> 3) << 2;
+                a = (readBytes4(bytes) << 32) | readBytes4(bytes + middle);
+                b = (readBytes4(bytes + length - 4) << 32) | readBytes4(bytes + length - 4 - middle);
+            }
+            else if (length > 0) {
+                a = (static_cast<uint64_t>(static_cast<unsigned char>(bytes[0])) << 16)
+                    | (static_cast<uint64_t>(static_cast<unsigned char>(bytes[length >> 1])) << 8)
+                    | static_cast<unsigned char>(bytes[length - 1]);
+            }
+        }
+        else {
+            size_t left = length;
+            for (; left > 16; left -= 16, bytes += 16) {
+                seed = multiplyFold(readBytes8(bytes) ^ SECRET[1], readBytes8(bytes + 8) ^ seed);
+            }
+            a = readBytes8(bytes + left - 16);
+            b = readBytes8(bytes + left - 8);
+        }
+        a ^= SECRET[1];
+        b ^= seed;
+        multiply128(a, b);
+        return multiplyFold(a ^ SECRET[0] ^ length, b ^ SECRET[1]);
+    }
+};
+
+/**
+ * FNV-1a: one xor and one multiply per byte of the id.
+ */
+struct MultiplicativeHash {
+    static uint64_t hash(const string& bidId) {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (char c : bidId) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+        }
+        return hash;
+    }
+};
+
+/**
+ * The id parsed as a number, what the table used before it
+ * hashed the bytes. Throws for ids that aren't numbers.
+ */
+struct StoiHash {
+    static uint64_t hash(const string& bidId) {
+        return static_cast<unsigned int>(stoi(bidId));
+    }
+};
+
 //============================================================================
 // Hash Table class definition
 //============================================================================
@@ -43,14 +171,31 @@ struct Bid {
 /**
  * Define a class containing data members and methods to
  * implement a hash table with chaining.
+ *
+ * The table grows once it holds more bids than buckets. Growing is
+ * incremental: the old buckets stay in oldNodes and every Insert and
+ * Remove moves the next few of them into the new table, so no single
+ * call pays for rehashing the whole table. Until a bucket has moved,
+ * its bids are looked for in both tables. Buckets only hold a pointer
+ * to their first node, so a new table costs one array of pointers.
+ *
+ * Nodes come from slabs the table owns, SLAB_NODES at a time, and a
+ * removed node goes on a free list for the next Insert instead of
+ * back to the heap. A recycled node keeps its strings' buffers, so
+ * copying a bid of about the same size into it allocates nothing.
+ * The slabs are only freed with the table.
+ *
+ * Hasher is the policy that turns a bid id into a 64-bit hash, a
+ * struct with a static hash(const string&) like the ones above.
  */
+template <typename Hasher = WyHash>
 class HashTable {
 
 private:
     // Define structures to hold bids
     struct Node {
         Bid bid;
-        unsigned int key;
+        uint64_t key; // the bid id's hash, so a rehash doesn't hash it again
         Node* next;
 
         // default constructor
@@ -65,33 +210,67 @@ private:
         }
 
         // initialize with a bid and a key
-        Node(Bid aBid, unsigned int aKey) : Node(aBid) {
+        Node(Bid aBid, uint64_t aKey) : Node(aBid) {
             key = aKey;
         }
     };
 
-    vector<Node> nodes;
+    static constexpr double MAX_LOAD_FACTOR = 1.0; // bids per bucket before the table grows
+    static constexpr unsigned int MIGRATE_BUCKETS = 4; // old buckets moved per Insert or Remove
+    static constexpr unsigned int SLAB_NODES = 256; // nodes allocated at a time
 
-    unsigned int tableSize = DEFAULT_SIZE;
+    vector<Node*> nodes;    // first node of each bucket, nullptr when it is empty
+    vector<Node*> oldNodes; // the buckets before the last growth, until all of them have moved
 
-    unsigned int hash(int key);
+    unsigned int tableSize = DEFAULT_SIZE;
+    unsigned int oldSize = 0;  // 0 when no rehash is under way
+    unsigned int migrated = 0; // old buckets already moved into nodes
+    unsigned int bidCount = 0;
+
+    vector<unique_ptr<Node[]> > slabs; // every node the table has made
+    unsigned int slabUsed = SLAB_NODES; // nodes handed out of the last slab
+    Node* freeNodes = nullptr; // removed nodes, linked through next
+
+    unsigned int hash(uint64_t key) const;
+    unsigned int hash(uint64_t key, unsigned int size) const;
+    void appendNode(unsigned int index, Node* node);
+    Node* allocateNode();
+    void releaseNode(Node* node);
+    void startRehash();
+    void migrateBuckets(unsigned int count);
+    bool removeFromBucket(Node*& head, const string& bidId);
+    void insertHashed(const Bid& bid, uint64_t key);
+    bool removeHashed(const string& bidId, uint64_t key);
+    Node* findHashed(const string& bidId, uint64_t key) const;
+    static Node* findInBucket(Node* node, const string& bidId);
+    static void printBucket(Node* node);
+    static unsigned int chainLength(const Node* node);
+
+    template <typename> friend class ConcurrentHashTable; // hashes an id once for its stripe and its bucket
 
 public:
     HashTable();
     HashTable(unsigned int size);
     virtual ~HashTable();
-    void Insert(Bid bid);
+    void Insert(const Bid& bid);
     void PrintAll();
     void Remove(string bidId);
     Bid Search(string bidId);
+    void FinishRehash();
+    unsigned int Size() const;
+    unsigned int BucketCount() const;
+    double LoadFactor() const;
+    unsigned int MaxChainLength() const;
+    vector<unsigned int> ChainLengthHistogram() const;
 };
 
 /**
  * Default constructor
  */
-HashTable::HashTable() {
+template <typename Hasher>
+HashTable<Hasher>::HashTable() {
     // FIXME (1): Initialize the structures used to hold bids
-    nodes.resize(tableSize); // Initalize node structure by resizing tableSize
+    nodes.resize(tableSize, nullptr); // Initalize node structure by resizing tableSize
 }
 
 /*
@@ -99,161 +278,773 @@ HashTable::HashTable() {
  * Use to improve efficiency of hashing algorithm
  * by reducing collisions without wasting memory.
  */
-HashTable::HashTable(unsigned int size) {
-    this->tableSize = size;  // invoke local tableSize to size with this->
-    nodes.resize(tableSize); // resize nodes size
+template <typename Hasher>
+HashTable<Hasher>::HashTable(unsigned int size) {
+    this->tableSize = max(size, 1u);  // invoke local tableSize to size with this->
+    nodes.resize(tableSize, nullptr); // resize nodes size
 }
 
 
 /**
  * Destructor
  */
-HashTable::~HashTable() {
-    // Iterate over the vector
-    for (int i = 0; i < this->tableSize; ++i) {
-        Node* node = nodes[i].next; // Start with the second node in the list, if any
-        // Traverse the linked list and delete the nodes
-        while (node != nullptr) {
-            Node* temp = node;
-            node = node->next;
-            delete temp; // Only delete nodes created with new (i.e., the linked nodes)
-        }
-    }
+template <typename Hasher>
+HashTable<Hasher>::~HashTable() {
+    // every node, in a bucket or on the free list, is in a slab, and the slabs free themselves
 }
 
 
 /**
- * Calculate the hash value of a given key.
- * Note that key is specifically defined as
- * unsigned int to prevent undefined results
- * of a negative list index.
+ * Calculate the bucket of a given key, the hash
+ * the Hasher policy made of a bid id.
  *
  * @param key The key to hash
  * @return The calculated hash
  */
-unsigned int HashTable::hash(int key) {
+template <typename Hasher>
+unsigned int HashTable<Hasher>::hash(uint64_t key) const {
     // FIXME (3): Implement logic to calculate a hash value
-    return static_cast<unsigned int>(key) % tableSize; // return key % tableSize as unsigned int
+    return hash(key, tableSize);
 }
 
 /**
- * Insert a bid
+ * Calculate the hash value of a key for a table of a given size,
+ * the old table's size while its buckets are being moved.
  *
- * @param bid The bid to insert
+ * @param key The key to hash
+ * @param size The number of buckets
+ * @return The calculated hash
  */
-void HashTable::Insert(Bid bid) {
-    unsigned int key = hash(stoi(bid.bidId)); // create the key for the given bid
-    Node* node = &(nodes[key]); // retrieve node using key
-    Node* prev = nullptr;
+template <typename Hasher>
+unsigned int HashTable<Hasher>::hash(uint64_t key, unsigned int size) const {
+    return static_cast<unsigned int>(key % size); // return key % size as unsigned int
+}
 
-    if (node->key == UINT_MAX) {
-        nodes[key] = Node(bid, key); // assign this node to the key position
+/**
+ * Append a node to the end of a bucket in the current table
+ *
+ * @param index The bucket
+ * @param node The node, not linked into any chain
+ */
+template <typename Hasher>
+void HashTable<Hasher>::appendNode(unsigned int index, Node* node) {
+    node->next = nullptr;
+    Node** link = &(nodes[index]);
+    while (*link != nullptr) {
+        link = &((*link)->next);
     }
-    else {
-        while (node->next != nullptr) {
-            node = node->next;
+    *link = node;
+}
+
+/**
+ * Take a node from the free list, or the next unused one of the
+ * last slab, starting a new slab when it is full
+ *
+ * @return A node not linked into any chain
+ */
+template <typename Hasher>
+typename HashTable<Hasher>::Node* HashTable<Hasher>::allocateNode() {
+    if (freeNodes != nullptr) {
+        Node* node = freeNodes;
+        freeNodes = node->next;
+        return node;
+    }
+    if (slabUsed == SLAB_NODES) {
+        slabs.emplace_back(new Node[SLAB_NODES]);
+        slabUsed = 0;
+    }
+    return &slabs.back()[slabUsed++];
+}
+
+/**
+ * Put a node unlinked from its chain on the free list. Its bid is
+ * left as it is, the next bid copied into it reuses the strings.
+ *
+ * @param node The node
+ */
+template <typename Hasher>
+void HashTable<Hasher>::releaseNode(Node* node) {
+    node->next = freeNodes;
+    freeNodes = node;
+}
+
+/**
+ * Start moving the bids into a table twice as large. The buckets
+ * move a few at a time in migrateBuckets.
+ */
+template <typename Hasher>
+void HashTable<Hasher>::startRehash() {
+    oldNodes.swap(nodes);
+    oldSize = tableSize;
+    migrated = 0;
+    tableSize = tableSize * 2 + 1; // keep the size odd, ids that come in runs spread over more buckets
+    nodes.assign(tableSize, nullptr);
+}
+
+/**
+ * Move up to count buckets of the old table into the current one,
+ * and drop the old table once every bucket has moved.
+ *
+ * @param count The number of old buckets to move
+ */
+template <typename Hasher>
+void HashTable<Hasher>::migrateBuckets(unsigned int count) {
+    for (; count > 0 && migrated < oldSize; --count, ++migrated) {
+        Node* node = oldNodes[migrated];
+        oldNodes[migrated] = nullptr;
+        while (node != nullptr) { // relink every node, nothing is copied
+            Node* next = node->next;
+            appendNode(hash(node->key), node);
+            node = next;
         }
-        node->next = new Node(bid, key); // Append new node at the end of the chain
+    }
+    if (oldSize != 0 && migrated == oldSize) {
+        vector<Node*>().swap(oldNodes); // free the old buckets
+        oldSize = 0;
     }
 }
 
+/**
+ * Insert a bid
+ *
+ * @param bid The bid to insert
+ */
+template <typename Hasher>
+void HashTable<Hasher>::Insert(const Bid& bid) {
+    insertHashed(bid, Hasher::hash(bid.bidId));
+}
+
+/**
+ * Insert a bid whose id was already hashed
+ *
+ * @param bid The bid to insert
+ * @param key The bid id's hash
+ */
+template <typename Hasher>
+void HashTable<Hasher>::insertHashed(const Bid& bid, uint64_t key) {
+    if (oldSize == 0 && bidCount + 1 > tableSize * MAX_LOAD_FACTOR) {
+        startRehash();
+    }
+    migrateBuckets(MIGRATE_BUCKETS);
+    Node* node = allocateNode();
+    node->bid = bid; // copied into a recycled node's strings where they are large enough
+    node->key = key;
+    appendNode(hash(key), node); // Append new node at the end of the chain
+    ++bidCount;
+}
+
 
 
 
 /**
- * Print all bids
+ * Print the bids of one bucket
  */
-void HashTable::PrintAll() {
-    // for node begin to end iterate
-    for (int i = 0; i < this->tableSize; ++i) {
-        Node* node = &(nodes[i]);
-        if (node->key != UINT_MAX) { // if key not equal to UINT_MAx
+template <typename Hasher>
+void HashTable<Hasher>::printBucket(Node* node) {
+    if (node != nullptr) { // if the bucket isn't empty
+        // output key, bidID, title, amount and fund
+        cout << node->bid.bidId << ": " << node->bid.title << " | " << node->bid.amount << " | " << node->bid.fund << endl;
+        // while next node not equal to nullptr
+        while (node->next != nullptr) {
+            node = node->next; // node is equal to next iter
             // output key, bidID, title, amount and fund
-            cout << node->bid.bidId << ": " << node->bid.title << " | " << node->bid.amount << " | " << node->bid.fund << endl;
-            // while next node not equal to nullptr
-            while (node->next != nullptr) {
-                node = node->next; // node is equal to next iter
-                // output key, bidID, title, amount and fund
-                cout << " -> " << node->bid.bidId << ": " << node->bid.title << " | " << node->bid.amount << " | " << node->bid.fund << endl;
-            }
+            cout << " -> " << node->bid.bidId << ": " << node->bid.title << " | " << node->bid.amount << " | " << node->bid.fund << endl;
         }
     }
 }
 
+/**
+ * Print all bids
+ */
+template <typename Hasher>
+void HashTable<Hasher>::PrintAll() {
+    // the buckets a rehash hasn't moved yet
+    for (unsigned int i = migrated; i < oldSize; ++i) {
+        printBucket(oldNodes[i]);
+    }
+    // for node begin to end iterate
+    for (unsigned int i = 0; i < this->tableSize; ++i) {
+        printBucket(nodes[i]);
+    }
+}
+
 
 /**
- * Remove a bid
+ * Remove a bid from one bucket
  *
+ * @param head The bucket's first node
  * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
  */
-void HashTable::Remove(string bidId) {
-    unsigned int key = hash(stoi(bidId));
-    Node* node = &(nodes[key]);
-    Node* prev = nullptr;
-
-    while (node != nullptr && node->key != UINT_MAX) {
+template <typename Hasher>
+bool HashTable<Hasher>::removeFromBucket(Node*& head, const string& bidId) {
+    // link points at whatever points at node, the bucket for the first node
+    for (Node** link = &head; *link != nullptr; link = &((*link)->next)) {
+        Node* node = *link;
         if (node->bid.bidId == bidId) {
-            if (prev != nullptr) {  // If not the first node in the list
-                prev->next = node->next; // Link previous node to the next node
-                delete node; // Free the memory of the current node
-                cout << "Bid removed." << endl;
-                return; // Exit the function
-            }
-            else { // If it is the first node in the list
-                if (node->next == nullptr) {
-                    node->key = UINT_MAX; // Mark the node as unused
-                    cout << "Bid removed." << endl;
-                    return; // Exit the function
-                }
-                else {
-                    // Move the first node of the list to the second node
-                    Node* temp = node->next;
-                    *node = *temp; // Copy the second node to the first node
-                    delete temp; // Delete the old second node
-                    cout << "Bid removed." << endl;
-                    return; // Exit the function
-                }
-            }
+            *link = node->next; // Link the previous node, or the bucket, to the next node
+            releaseNode(node); // keep the node for the next Insert
+            return true;
         }
-        prev = node; // Keep track of the previous node
-        node = node->next; // Move to the next node in the list
     }
-    cout << "Bid Id " << bidId << " not found." << endl;
+    return false;
 }
 
-
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ */
+template <typename Hasher>
+void HashTable<Hasher>::Remove(string bidId) {
+    if (removeHashed(bidId, Hasher::hash(bidId))) {
+        cout << "Bid removed." << endl;
+        return; // Exit the function
+    }
+    cout << "Bid Id " << bidId << " not found." << endl;
+}
 
 /**
- * Search for the specified bidId
+ * Remove a bid whose id was already hashed
  *
  * @param bidId The bid id to search for
+ * @param key The bid id's hash
+ * @return true if the bid was found and removed
  */
-Bid HashTable::Search(string bidId) {
-    Bid bid;
+template <typename Hasher>
+bool HashTable<Hasher>::removeHashed(const string& bidId, uint64_t key) {
+    migrateBuckets(MIGRATE_BUCKETS);
 
-    unsigned int key = hash(stoi(bidId)); // create the key for the given bid
+    bool removed = false;
+    if (oldSize != 0 && hash(key, oldSize) >= migrated) { // its bucket hasn't moved yet
+        removed = removeFromBucket(oldNodes[hash(key, oldSize)], bidId);
+    }
+    if (!removed) {
+        removed = removeFromBucket(nodes[hash(key)], bidId);
+    }
+    if (removed) {
+        --bidCount;
+    }
+    return removed;
+}
 
-    // attempt to find the bid at the hashed index
-    Node* node = &(nodes[key]);
 
-    // if the bucket is empty (key is UINT_MAX), the bid is not in the table
-    if (node->key == UINT_MAX) {
-        return bid; // return an empty bid
-    }
 
+/**
+ * Find a bid in one bucket
+ *
+ * @param node The bucket's first node
+ * @param bidId The bid id to search for
+ * @return The node holding the bid, or nullptr
+ */
+template <typename Hasher>
+typename HashTable<Hasher>::Node* HashTable<Hasher>::findInBucket(Node* node, const string& bidId) {
     // while node not equal to nullptr
     while (node != nullptr) {
         // if the current node matches
         if (node->bid.bidId == bidId) {
-            return node->bid; // return it the bid
+            return node;
         }
         node = node->next; // Move to the next node
     }
+    return nullptr;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+template <typename Hasher>
+Bid HashTable<Hasher>::Search(string bidId) {
+    Bid bid;
+
+    Node* node = findHashed(bidId, Hasher::hash(bidId)); // create the key for the given bid
+    if (node != nullptr) {
+        return node->bid; // return it the bid
+    }
 
     // The bid was not found in the hash table
     return bid; //node is equal to next node
 }
 
+/**
+ * Find a bid whose id was already hashed, changes nothing
+ *
+ * @param bidId The bid id to search for
+ * @param key The bid id's hash
+ * @return The node holding the bid, or nullptr
+ */
+template <typename Hasher>
+typename HashTable<Hasher>::Node* HashTable<Hasher>::findHashed(const string& bidId, uint64_t key) const {
+    // a bucket the rehash hasn't moved yet is still in the old table,
+    // bids inserted since then are in the new one
+    Node* node = nullptr;
+    if (oldSize != 0 && hash(key, oldSize) >= migrated) {
+        node = findInBucket(oldNodes[hash(key, oldSize)], bidId);
+    }
+    if (node == nullptr) {
+        node = findInBucket(nodes[hash(key)], bidId);
+    }
+    return node;
+}
+
+/**
+ * Move every bucket a rehash hasn't moved yet, e.g. before
+ * a long run of searches
+ */
+template <typename Hasher>
+void HashTable<Hasher>::FinishRehash() {
+    migrateBuckets(oldSize - migrated);
+}
+
+/**
+ * Number of bids in the table
+ */
+template <typename Hasher>
+unsigned int HashTable<Hasher>::Size() const {
+    return bidCount;
+}
+
+/**
+ * Number of buckets in the current table
+ */
+template <typename Hasher>
+unsigned int HashTable<Hasher>::BucketCount() const {
+    return tableSize;
+}
+
+/**
+ * Bids per bucket of the current table
+ */
+template <typename Hasher>
+double HashTable<Hasher>::LoadFactor() const {
+    return static_cast<double>(bidCount) / tableSize;
+}
+
+/**
+ * Number of bids in one bucket
+ */
+template <typename Hasher>
+unsigned int HashTable<Hasher>::chainLength(const Node* node) {
+    unsigned int length = 0;
+    for (; node != nullptr; node = node->next) {
+        ++length;
+    }
+    return length;
+}
+
+/**
+ * Number of bids in the longest chain, in either table. Walks every bucket.
+ */
+template <typename Hasher>
+unsigned int HashTable<Hasher>::MaxChainLength() const {
+    unsigned int longest = 0;
+    for (unsigned int i = migrated; i < oldSize; ++i) {
+        longest = max(longest, chainLength(oldNodes[i]));
+    }
+    for (unsigned int i = 0; i < tableSize; ++i) {
+        longest = max(longest, chainLength(nodes[i]));
+    }
+    return longest;
+}
+
+/**
+ * Number of buckets of each chain length, in both tables,
+ * entry i for chains of i bids. Walks every bucket.
+ */
+template <typename Hasher>
+vector<unsigned int> HashTable<Hasher>::ChainLengthHistogram() const {
+    vector<unsigned int> histogram;
+    auto count = [&histogram](unsigned int length) {
+        if (length >= histogram.size()) {
+            histogram.resize(length + 1, 0);
+        }
+        ++histogram[length];
+    };
+    for (unsigned int i = migrated; i < oldSize; ++i) {
+        count(chainLength(oldNodes[i]));
+    }
+    for (unsigned int i = 0; i < tableSize; ++i) {
+        count(chainLength(nodes[i]));
+    }
+    return histogram;
+}
+
+
+//============================================================================
+// Concurrent hash table definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to
+ * implement a hash table that several threads can use at once.
+ *
+ * The bids are split over STRIPE_COUNT stripes by the top bits of
+ * their id's hash, and each stripe is a HashTable of its own behind
+ * its own lock. Threads only wait for each other when they use the
+ * same stripe. Searches take the lock shared, so they don't wait
+ * for each other at all. Inserts and removes take it exclusively.
+ * Each stripe grows on its own, with the incremental rehash.
+ *
+ * Nothing is printed, Remove says whether it removed the bid, so
+ * threads don't take turns on the console.
+ */
+template <typename Hasher = WyHash>
+class ConcurrentHashTable {
+
+private:
+    static constexpr unsigned int STRIPE_BITS = 6;
+    static constexpr unsigned int STRIPE_COUNT = 1u << STRIPE_BITS;
+
+    // a stripe fills whole cache lines, so two threads on neighboring
+    // stripes don't pull the same line back and forth
+    struct alignas(64) Stripe {
+        mutable shared_mutex lock;
+        HashTable<Hasher> table;
+    };
+
+    Stripe stripes[STRIPE_COUNT];
+
+    Stripe& stripeOf(uint64_t key) { return stripes[key >> (64 - STRIPE_BITS)]; }
+    const Stripe& stripeOf(uint64_t key) const { return stripes[key >> (64 - STRIPE_BITS)]; }
+
+public:
+    void Insert(const Bid& bid);
+    bool Remove(const string& bidId);
+    Bid Search(const string& bidId) const;
+    void PrintAll();
+    unsigned int Size() const;
+};
+
+/**
+ * Insert a bid
+ *
+ * @param bid The bid to insert
+ */
+template <typename Hasher>
+void ConcurrentHashTable<Hasher>::Insert(const Bid& bid) {
+    uint64_t key = Hasher::hash(bid.bidId); // hashed before the lock is taken
+    Stripe& stripe = stripeOf(key);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    stripe.table.insertHashed(bid, key);
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+template <typename Hasher>
+bool ConcurrentHashTable<Hasher>::Remove(const string& bidId) {
+    uint64_t key = Hasher::hash(bidId);
+    Stripe& stripe = stripeOf(key);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    return stripe.table.removeHashed(bidId, key);
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return A copy of the bid, an empty bid if it isn't in the table
+ */
+template <typename Hasher>
+Bid ConcurrentHashTable<Hasher>::Search(const string& bidId) const {
+    uint64_t key = Hasher::hash(bidId);
+    const Stripe& stripe = stripeOf(key);
+    shared_lock<shared_mutex> guard(stripe.lock);
+    auto node = stripe.table.findHashed(bidId, key);
+    return node != nullptr ? node->bid : Bid(); // copied while the lock is held
+}
+
+/**
+ * Print all bids, a stripe at a time
+ */
+template <typename Hasher>
+void ConcurrentHashTable<Hasher>::PrintAll() {
+    for (Stripe& stripe : stripes) {
+        shared_lock<shared_mutex> guard(stripe.lock);
+        stripe.table.PrintAll();
+    }
+}
+
+/**
+ * Number of bids in the table. Threads inserting or removing
+ * meanwhile may or may not be counted.
+ */
+template <typename Hasher>
+unsigned int ConcurrentHashTable<Hasher>::Size() const {
+    unsigned int count = 0;
+    for (const Stripe& stripe : stripes) {
+        shared_lock<shared_mutex> guard(stripe.lock);
+        count += stripe.table.Size();
+    }
+    return count;
+}
+
+
+//============================================================================
+// Open-addressing hash table definition
+//============================================================================
+
+/**
+ * Index of the lowest set bit of a mask that isn't 0.
+ */
+static inline unsigned int lowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * Define a class containing data members and methods to
+ * implement a hash table with open addressing, Swiss table style.
+ *
+ * The bids live in one array of slots, with one control byte per
+ * slot: EMPTY, DELETED, or the low 7 bits of the hash of the bid in
+ * the slot. A search looks at a group of 16 control bytes at a time.
+ * One SSE2 compare finds every slot in the group whose 7 bits match,
+ * so almost the only bid id compared is the right one. A group with
+ * an EMPTY byte ends the search. Groups are probed quadratically,
+ * and nothing is allocated per bid.
+ *
+ * Insert replaces a bid whose id is already in the table.
+ */
+class SwissHashTable {
+
+private:
+    static constexpr unsigned int GROUP_SIZE = 16;
+    static constexpr signed char EMPTY = -128; // never held a bid, ends a search
+    static constexpr signed char DELETED = -2; // held a removed bid, a search goes past it
+
+    vector<signed char> control; // one byte per slot
+    vector<Bid> slots;
+    size_t groupMask;    // number of groups - 1, the number of groups is a power of two
+    size_t bidCount;
+    size_t deletedCount;
+
+    uint32_t matchByte(size_t group, signed char byte) const;
+    uint32_t matchEmpty(size_t group) const;
+    uint32_t matchFree(size_t group) const;
+    size_t findSlot(const string& bidId, uint64_t hash) const;
+    size_t freeSlot(uint64_t hash) const;
+    void rehash(size_t groupCount);
+
+public:
+    SwissHashTable();
+    SwissHashTable(unsigned int size);
+    void Insert(Bid bid);
+    void PrintAll();
+    void Remove(string bidId);
+    Bid Search(string bidId);
+    size_t Size() const { return bidCount; }
+};
+
+/**
+ * Default constructor
+ */
+SwissHashTable::SwissHashTable() : SwissHashTable(DEFAULT_SIZE) {
+}
+
+/*
+ * Constructor for specifying how many bids the table
+ * should hold before it has to grow.
+ */
+SwissHashTable::SwissHashTable(unsigned int size) : groupMask(0), bidCount(0), deletedCount(0) {
+    size_t groupCount = 1;
+    while (groupCount * GROUP_SIZE * 7 / 8 < size) { // tables grow past 7/8 full
+        groupCount *= 2;
+    }
+    rehash(groupCount);
+}
+
+/**
+ * Mask of the slots in a group whose control byte is byte,
+ * bit i for slot i of the group.
+ */
+uint32_t SwissHashTable::matchByte(size_t group, signed char byte) const {
+    const signed char* bytes = &control[group * GROUP_SIZE];
+#ifdef SWISS_SSE2
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(byte))));
+#else
+    uint32_t mask = 0;
+    for (unsigned int i = 0; i < GROUP_SIZE; ++i) {
+        mask |= static_cast<uint32_t>(bytes[i] == byte) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Mask of the EMPTY slots in a group.
+ */
+uint32_t SwissHashTable::matchEmpty(size_t group) const {
+    return matchByte(group, EMPTY);
+}
+
+/**
+ * Mask of the EMPTY or DELETED slots in a group. Those are the only
+ * control bytes with the high bit set, so SSE2 reads them straight
+ * out of the sign bits.
+ */
+uint32_t SwissHashTable::matchFree(size_t group) const {
+    const signed char* bytes = &control[group * GROUP_SIZE];
+#ifdef SWISS_SSE2
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))));
+#else
+    uint32_t mask = 0;
+    for (unsigned int i = 0; i < GROUP_SIZE; ++i) {
+        mask |= static_cast<uint32_t>(bytes[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Find the slot holding a bid id.
+ *
+ * @param bidId The bid id to search for
+ * @param hash The bid id's hash
+ * @return The slot, or SIZE_MAX if the id isn't in the table
+ */
+size_t SwissHashTable::findSlot(const string& bidId, uint64_t hash) const {
+    signed char tag = static_cast<signed char>(hash & 0x7F);
+    size_t group = (hash >> 7) & groupMask;
+    for (size_t step = 1; ; ++step) {
+        uint32_t mask = matchByte(group, tag);
+        while (mask != 0) {
+            size_t slot = group * GROUP_SIZE + lowestBit(mask);
+            if (slots[slot].bidId == bidId) {
+                return slot;
+            }
+            mask &= mask - 1; // next match
+        }
+        if (matchEmpty(group) != 0 || step > groupMask) { // an insert would have stopped here
+            return SIZE_MAX;
+        }
+        group = (group + step) & groupMask; // 1, 2, 3... groups on, visits every group once
+    }
+}
+
+/**
+ * First EMPTY or DELETED slot on a hash's probe sequence.
+ * The table always has one, it grows before it fills.
+ */
+size_t SwissHashTable::freeSlot(uint64_t hash) const {
+    size_t group = (hash >> 7) & groupMask;
+    for (size_t step = 1; ; ++step) {
+        uint32_t mask = matchFree(group);
+        if (mask != 0) {
+            return group * GROUP_SIZE + lowestBit(mask);
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * Move every bid into a table of groupCount groups,
+ * dropping the DELETED markers on the way.
+ */
+void SwissHashTable::rehash(size_t groupCount) {
+    vector<signed char> oldControl(groupCount * GROUP_SIZE, EMPTY);
+    vector<Bid> oldSlots(groupCount * GROUP_SIZE);
+    oldControl.swap(control);
+    oldSlots.swap(slots);
+    groupMask = groupCount - 1;
+    deletedCount = 0;
+    for (size_t i = 0; i < oldControl.size(); ++i) {
+        if (oldControl[i] >= 0) { // a full slot
+            uint64_t hash = WyHash::hash(oldSlots[i].bidId);
+            size_t slot = freeSlot(hash);
+            control[slot] = static_cast<signed char>(hash & 0x7F);
+            slots[slot] = std::move(oldSlots[i]);
+        }
+    }
+}
+
+/**
+ * Insert a bid
+ *
+ * @param bid The bid to insert
+ */
+void SwissHashTable::Insert(Bid bid) {
+    uint64_t hash = WyHash::hash(bid.bidId);
+    size_t slot = findSlot(bid.bidId, hash);
+    if (slot != SIZE_MAX) { // the id is already here, take the new bid
+        slots[slot] = std::move(bid);
+        return;
+    }
+    size_t capacity = control.size();
+    if ((bidCount + deletedCount + 1) > capacity * 7 / 8) {
+        // double when the bids fill the table, otherwise the DELETED markers do and a rehash in place clears them
+        rehash(bidCount + 1 > capacity * 7 / 16 ? (groupMask + 1) * 2 : groupMask + 1);
+    }
+    slot = freeSlot(hash);
+    if (control[slot] == DELETED) {
+        --deletedCount;
+    }
+    control[slot] = static_cast<signed char>(hash & 0x7F);
+    slots[slot] = std::move(bid);
+    ++bidCount;
+}
+
+/**
+ * Print all bids, in slot order
+ */
+void SwissHashTable::PrintAll() {
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (control[i] >= 0) { // a full slot
+            cout << slots[i].bidId << ": " << slots[i].title << " | " << slots[i].amount << " | " << slots[i].fund << endl;
+        }
+    }
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ */
+void SwissHashTable::Remove(string bidId) {
+    size_t slot = findSlot(bidId, WyHash::hash(bidId));
+    if (slot == SIZE_MAX) {
+        cout << "Bid Id " << bidId << " not found." << endl;
+        return;
+    }
+    // a search only ever got past this group if it had no EMPTY slot,
+    // so with one the slot can go back to EMPTY, otherwise it must be DELETED
+    size_t group = slot / GROUP_SIZE;
+    if (matchEmpty(group) != 0) {
+        control[slot] = EMPTY;
+    }
+    else {
+        control[slot] = DELETED;
+        ++deletedCount;
+    }
+    slots[slot] = Bid(); // free the strings now
+    --bidCount;
+    cout << "Bid removed." << endl;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+Bid SwissHashTable::Search(string bidId) {
+    size_t slot = findSlot(bidId, WyHash::hash(bidId));
+    if (slot == SIZE_MAX) {
+        return Bid(); // return an empty bid
+    }
+    return slots[slot];
+}
+
 
 //============================================================================
 // Static methods used for testing
@@ -270,13 +1061,28 @@ void displayBid(Bid bid) {
     return;
 }
 
+/**
+ * Create a bid from one row of an eBid CSV file
+ *
+ * @param row The row to read
+ * @return The bid the row describes
+ */
+Bid bidFromRow(csv::Row& row) {
+    Bid bid;
+    bid.bidId = row[1];
+    bid.title = row[0];
+    bid.fund = row[8];
+    bid.amount = strToDouble(row[4], '$');
+    return bid;
+}
+
 /**
  * Load a CSV file containing bids into a container
  *
  * @param csvPath the path to the CSV file to load
  * @return a container holding all the bids read
  */
-void loadBids(string csvPath, HashTable* hashTable) {
+void loadBids(string csvPath, HashTable<>* hashTable) {
     cout << "Loading CSV file " << csvPath << endl;
 
     // initialize the CSV Parser using the given path
@@ -294,11 +1100,7 @@ void loadBids(string csvPath, HashTable* hashTable) {
         for (unsigned int i = 0; i < file.rowCount(); i++) {
 
             // Create a data structure and add to the collection of bids
-            Bid bid;
-            bid.bidId = file[i][1];
-            bid.title = file[i][0];
-            bid.fund = file[i][8];
-            bid.amount = strToDouble(file[i][4], '$');
+            Bid bid = bidFromRow(file[i]);
 
             //cout << "Item: " << bid.title << ", Fund: " << bid.fund << ", Amount: " << bid.amount << endl;
 
@@ -311,6 +1113,399 @@ void loadBids(string csvPath, HashTable* hashTable) {
     }
 }
 
+/**
+ * Read every bid of a CSV file into memory, so a benchmark
+ * times the tables and not the parser
+ *
+ * @param csvPath the path to the CSV file to load
+ * @return the bids in file order
+ */
+vector<Bid> readBids(string csvPath) {
+    vector<Bid> bids;
+    try {
+        csv::Parser file = csv::Parser(csvPath);
+        bids.reserve(file.rowCount());
+        for (unsigned int i = 0; i < file.rowCount(); i++) {
+            bids.push_back(bidFromRow(file[i]));
+        }
+    }
+    catch (csv::Error& e) {
+        std::cerr << e.what() << std::endl;
+    }
+    return bids;
+}
+
+/**
+ * Time one kind of table on a set of bids: inserting all of them,
+ * searching for each, searching for ids that aren't there, removing
+ * each and inserting it again, and removing all of them. Each step is repeated on a fresh table until
+ * about a million operations were timed, and reported in nanoseconds
+ * per operation.
+ *
+ * @param name The name to report the table under
+ * @param bids The bids to insert
+ * @param misses Bid ids that aren't in bids
+ */
+template <typename Table>
+void benchmarkTable(const char* name, const vector<Bid>& bids, const vector<string>& misses) {
+    typedef chrono::steady_clock Clock;
+    size_t rounds = max<size_t>(1, 1000000 / bids.size());
+    double insertTime = 0.0, hitTime = 0.0, missTime = 0.0, churnTime = 0.0, removeTime = 0.0;
+    size_t found = 0;
+
+    for (size_t round = 0; round < rounds; ++round) {
+        Table* table = new Table();
+
+        Clock::time_point start = Clock::now();
+        for (const Bid& bid : bids) {
+            table->Insert(bid);
+        }
+        insertTime += chrono::duration<double, nano>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (const Bid& bid : bids) {
+            found += !table->Search(bid.bidId).bidId.empty();
+        }
+        hitTime += chrono::duration<double, nano>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (const string& bidId : misses) {
+            found += !table->Search(bidId).bidId.empty();
+        }
+        missTime += chrono::duration<double, nano>(Clock::now() - start).count();
+
+        streambuf* console = cout.rdbuf(nullptr); // Remove reports every bid, keep it quiet
+        start = Clock::now();
+        for (size_t i = 0; i < bids.size(); ++i) { // take a bid out and put it back, in a scattered order
+            const Bid& bid = bids[(i * 7919) % bids.size()];
+            table->Remove(bid.bidId);
+            table->Insert(bid);
+        }
+        churnTime += chrono::duration<double, nano>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (const Bid& bid : bids) {
+            table->Remove(bid.bidId);
+        }
+        removeTime += chrono::duration<double, nano>(Clock::now() - start).count();
+        cout.rdbuf(console);
+        cout.clear();
+
+        delete table;
+    }
+
+    double operations = static_cast<double>(rounds * bids.size());
+    cout << "  " << name << ": insert " << insertTime / operations << " ns, search " << hitTime / operations
+        << " ns, search missing " << missTime / operations << " ns, remove and insert " << churnTime / operations
+        << " ns, remove " << removeTime / operations << " ns";
+    if (found != rounds * bids.size()) {
+        cout << " (found " << found << " of " << rounds * bids.size() << " bids)";
+    }
+    cout << endl;
+}
+
+/**
+ * Compare the chained and open-addressing tables on the bids of a CSV file
+ *
+ * @param csvPath the path to the CSV file to load
+ */
+void benchmarkTables(string csvPath) {
+    vector<Bid> bids = readBids(csvPath);
+    if (bids.empty()) {
+        cout << "No bids in " << csvPath << endl;
+        return;
+    }
+
+    // ids past the largest numeric id, so they are missing from both tables
+    long long largest = 0;
+    for (const Bid& bid : bids) {
+        largest = max(largest, atoll(bid.bidId.c_str()));
+    }
+    vector<string> misses;
+    for (size_t i = 0; i < bids.size(); ++i) {
+        misses.push_back(to_string(largest + 1 + static_cast<long long>(i)));
+    }
+
+    cout << bids.size() << " bids from " << csvPath << ", times per operation:" << endl;
+    benchmarkTable<HashTable<> >("chained", bids, misses);
+    benchmarkTable<SwissHashTable>("open addressing", bids, misses);
+}
+
+/**
+ * Time every Insert into a growing table and report the latencies
+ * for each tenth of the bids, so a stall while the table grows
+ * shows up in the tenth it happens in.
+ *
+ * @param csvPath the path to the CSV file to load
+ */
+void benchmarkInsertLatency(string csvPath) {
+    typedef chrono::steady_clock Clock;
+    vector<Bid> bids = readBids(csvPath);
+    if (bids.size() < 10) {
+        cout << "Not enough bids in " << csvPath << endl;
+        return;
+    }
+
+    HashTable<>* table = new HashTable<>();
+    vector<double> latencies(bids.size());
+    cout << bids.size() << " bids from " << csvPath << ", insert latency per tenth:" << endl;
+    size_t first = 0;
+    for (size_t tenth = 1; tenth <= 10; ++tenth) {
+        size_t last = bids.size() * tenth / 10;
+        for (size_t i = first; i < last; ++i) {
+            Clock::time_point start = Clock::now();
+            table->Insert(bids[i]);
+            latencies[i] = chrono::duration<double, nano>(Clock::now() - start).count();
+        }
+        sort(latencies.begin() + first, latencies.begin() + last);
+        size_t count = last - first;
+        cout << "  " << last << " bids, " << table->BucketCount() << " buckets, load factor " << table->LoadFactor()
+            << ": p50 " << latencies[first + count / 2] << " ns, p99 " << latencies[first + count * 99 / 100]
+            << " ns, max " << latencies[last - 1] << " ns" << endl;
+        first = last;
+    }
+    cout << "  longest chain " << table->MaxChainLength() << endl;
+    delete table;
+}
+
+/**
+ * Load the bids into a table using one hash policy and report how
+ * long hashing, inserting and searching take, how many bids landed
+ * in a bucket that already held one, and how many buckets hold
+ * chains of each length. A random hash is expected to leave
+ * buckets * (1 - 1/buckets)^bids of the buckets empty, the
+ * collisions that leaves are shown for comparison.
+ *
+ * @param name The name to report the policy under
+ * @param bids The bids to insert
+ */
+template <typename Hasher>
+void reportHashPolicy(const char* name, const vector<Bid>& bids) {
+    typedef chrono::steady_clock Clock;
+    HashTable<Hasher>* table = new HashTable<Hasher>();
+
+    uint64_t mixed = 0; // keeps the hashing loop from being optimized away
+    size_t rounds = max<size_t>(1, 1000000 / bids.size()); // hash about a million ids
+    Clock::time_point start = Clock::now();
+    try {
+        for (size_t round = 0; round < rounds; ++round) {
+            for (const Bid& bid : bids) {
+                mixed += Hasher::hash(bid.bidId);
+            }
+        }
+    }
+    catch (const exception&) { // stoi on an id that isn't a number
+        cout << "  " << name << ": can't hash every bid id of this file" << endl;
+        delete table;
+        return;
+    }
+    double hashTime = chrono::duration<double, nano>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (const Bid& bid : bids) {
+        table->Insert(bid);
+    }
+    double insertTime = chrono::duration<double, nano>(Clock::now() - start).count();
+
+    size_t found = 0;
+    start = Clock::now();
+    for (const Bid& bid : bids) {
+        found += !table->Search(bid.bidId).bidId.empty();
+    }
+    double searchTime = chrono::duration<double, nano>(Clock::now() - start).count();
+
+    table->FinishRehash(); // count the buckets of one table
+    vector<unsigned int> histogram = table->ChainLengthHistogram();
+    double buckets = table->BucketCount();
+    unsigned int collisions = table->Size() - (table->BucketCount() - histogram[0]);
+    double expected = table->Size() - buckets * (1.0 - pow(1.0 - 1.0 / buckets, static_cast<double>(table->Size())));
+
+    cout << "  " << name << ": hash " << hashTime / (rounds * bids.size()) << " ns, insert " << insertTime / bids.size()
+        << " ns, search " << searchTime / bids.size() << " ns" << (mixed == 1 ? " " : "") << endl;
+    cout << "    " << table->BucketCount() << " buckets, " << collisions << " collisions (random hash "
+        << static_cast<unsigned int>(expected + 0.5) << "), chain lengths";
+    for (size_t length = 0; length < histogram.size(); ++length) {
+        cout << " " << length << ":" << histogram[length];
+    }
+    cout << endl;
+    if (found != bids.size()) {
+        cout << "    found " << found << " of " << bids.size() << " bids" << endl;
+    }
+    delete table;
+}
+
+/**
+ * Compare the bid id hash policies on the bids of a CSV file
+ *
+ * @param csvPath the path to the CSV file to load
+ */
+void compareHashPolicies(string csvPath) {
+    vector<Bid> bids = readBids(csvPath);
+    if (bids.empty()) {
+        cout << "No bids in " << csvPath << endl;
+        return;
+    }
+    cout << bids.size() << " bids from " << csvPath << ", per bid:" << endl;
+    reportHashPolicy<WyHash>("wyhash", bids);
+    reportHashPolicy<MultiplicativeHash>("multiplicative (FNV-1a)", bids);
+    reportHashPolicy<StoiHash>("stoi", bids);
+}
+
+/**
+ * Time the concurrent table with 1, 2, 4 ... 32 threads. First the
+ * threads load the bids, each inserting its share as when several
+ * files load at once. Then they run a mix of 9 searches to 1 remove,
+ * and a remove that succeeds puts the bid back. Reported in millions
+ * of operations a second and as the speedup over one thread.
+ *
+ * @param csvPath the path to the CSV file to load
+ */
+void benchmarkConcurrentTable(string csvPath) {
+    typedef chrono::steady_clock Clock;
+    const size_t MIXED_OPERATIONS = 4000000; // split over the threads
+    vector<Bid> bids = readBids(csvPath);
+    if (bids.empty()) {
+        cout << "No bids in " << csvPath << endl;
+        return;
+    }
+
+    cout << bids.size() << " bids from " << csvPath << ", " << thread::hardware_concurrency() << " hardware threads:" << endl;
+    double loadBase = 0.0, mixedBase = 0.0;
+    for (unsigned int threads = 1; threads <= 32; threads *= 2) {
+        ConcurrentHashTable<>* table = new ConcurrentHashTable<>();
+        vector<thread> workers;
+
+        Clock::time_point start = Clock::now();
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back([&bids, table, threads, t]() {
+                for (size_t i = t; i < bids.size(); i += threads) {
+                    table->Insert(bids[i]);
+                }
+            });
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        double loadRate = bids.size() / chrono::duration<double>(Clock::now() - start).count() / 1e6;
+        workers.clear();
+
+        atomic<size_t> found(0);
+        start = Clock::now();
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back([&bids, &found, table, threads, t, MIXED_OPERATIONS]() {
+                uint64_t random = 0x9E3779B97F4A7C15ULL * (t + 1); // xorshift, different bids for every thread
+                size_t hits = 0;
+                for (size_t op = 0; op < MIXED_OPERATIONS / threads; ++op) {
+                    random ^= random << 13;
+                    random ^= random >> 7;
+                    random ^= random << 17;
+                    const Bid& bid = bids[random % bids.size()];
+                    if (op % 10 == 9) {
+                        if (table->Remove(bid.bidId)) {
+                            table->Insert(bid);
+                        }
+                    }
+                    else {
+                        hits += !table->Search(bid.bidId).bidId.empty();
+                    }
+                }
+                found += hits;
+            });
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        double mixedRate = (MIXED_OPERATIONS / threads) * threads / chrono::duration<double>(Clock::now() - start).count() / 1e6;
+
+        if (threads == 1) {
+            loadBase = loadRate;
+            mixedBase = mixedRate;
+        }
+        cout << "  " << threads << " threads: load " << loadRate << " M bids/sec (x" << loadRate / loadBase << "), search/remove "
+            << mixedRate << " M ops/sec (x" << mixedRate / mixedBase << ")";
+        if (table->Size() != bids.size()) {
+            cout << ", " << table->Size() << " bids left of " << bids.size();
+        }
+        cout << endl;
+        delete table;
+    }
+}
+
+/**
+ * Check that no insert gets lost when threads use the concurrent
+ * table at once. Every writer inserts bids of its own and removes
+ * every fourth one again straight away, while readers search all
+ * the time. A read must never return a bid other than the one asked
+ * for or with a half-written title. Afterwards every kept bid must be
+ * found, no removed bid may be, and the size must add up.
+ *
+ * @return true if every check passed
+ */
+bool stressConcurrentTable() {
+    const unsigned int PER_THREAD = 20000;
+    const unsigned int READERS = 4;
+    bool passed = true;
+
+    for (unsigned int writers = 2; writers <= 32; writers *= 4) {
+        ConcurrentHashTable<>* table = new ConcurrentHashTable<>();
+        atomic<bool> writing(true);
+        atomic<unsigned int> torn(0);
+        vector<thread> threads;
+        for (unsigned int w = 0; w < writers; ++w) {
+            threads.emplace_back([table, w, PER_THREAD]() {
+                for (unsigned int i = 0; i < PER_THREAD; ++i) {
+                    Bid bid;
+                    bid.bidId = "S" + to_string(w) + "-" + to_string(i);
+                    bid.title = "stress";
+                    table->Insert(bid);
+                    if (i % 4 == 0) {
+                        table->Remove("S" + to_string(w) + "-" + to_string(i));
+                    }
+                }
+            });
+        }
+        for (unsigned int r = 0; r < READERS; ++r) {
+            threads.emplace_back([table, &writing, &torn, writers, r, PER_THREAD]() {
+                uint64_t random = 0x2545F4914F6CDD1DULL * (r + 1);
+                while (writing) {
+                    random ^= random << 13;
+                    random ^= random >> 7;
+                    random ^= random << 17;
+                    string bidId = "S" + to_string(random % writers) + "-" + to_string((random >> 8) % PER_THREAD);
+                    Bid bid = table->Search(bidId);
+                    if (!bid.bidId.empty() && (bid.bidId != bidId || bid.title != "stress")) {
+                        ++torn; // counted, the threads don't share cout
+                    }
+                }
+            });
+        }
+        for (unsigned int w = 0; w < writers; ++w) {
+            threads[w].join();
+        }
+        writing = false;
+        for (unsigned int r = 0; r < READERS; ++r) {
+            threads[writers + r].join();
+        }
+
+        unsigned int lost = 0, kept = 0;
+        for (unsigned int w = 0; w < writers; ++w) {
+            for (unsigned int i = 0; i < PER_THREAD; ++i) {
+                bool present = !table->Search("S" + to_string(w) + "-" + to_string(i)).bidId.empty();
+                if (present != (i % 4 != 0)) {
+                    ++lost; // a kept bid went missing or a removed one came back
+                }
+                kept += present;
+            }
+        }
+        bool ok = lost == 0 && torn == 0 && table->Size() == kept && kept == writers * PER_THREAD / 4 * 3;
+        cout << "  " << writers << " writers, " << READERS << " readers: " << writers * PER_THREAD << " inserts, "
+            << kept << " bids kept, " << lost << " wrong, " << torn << " torn reads, size " << table->Size() << (ok ? ", ok" : ", FAILED") << endl;
+        passed = passed && ok;
+        delete table;
+    }
+    return passed;
+}
+
 /**
  * Simple C function to convert a string to a double
  * after stripping out unwanted char
@@ -352,10 +1547,10 @@ int main(int argc, char* argv[]) {
     clock_t ticks;
 
     // Define a hash table to hold all the bids
-    HashTable* bidTable;
+    HashTable<>* bidTable;
 
     Bid bid;
-    bidTable = new HashTable();
+    bidTable = new HashTable<>();
 
     int choice = 0;
     while (choice != 9) {
@@ -364,6 +1559,10 @@ int main(int argc, char* argv[]) {
         cout << "  2. Display All Bids" << endl;
         cout << "  3. Find Bid" << endl;
         cout << "  4. Remove Bid" << endl;
+        cout << "  5. Benchmark Tables" << endl;
+        cout << "  6. Insert Latency" << endl;
+        cout << "  7. Compare Hash Policies" << endl;
+        cout << "  8. Concurrent Benchmark" << endl;
         cout << "  9. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
@@ -382,6 +1581,8 @@ int main(int argc, char* argv[]) {
             ticks = clock() - ticks; // current clock ticks minus starting clock ticks
             cout << "time: " << ticks << " clock ticks" << endl;
             cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            cout << bidTable->Size() << " bids in " << bidTable->BucketCount() << " buckets, load factor "
+                << bidTable->LoadFactor() << ", longest chain " << bidTable->MaxChainLength() << endl;
             break;
 
         case 2:
@@ -409,6 +1610,24 @@ int main(int argc, char* argv[]) {
         case 4:
             bidTable->Remove(bidKey);
             break;
+
+        case 5:
+            benchmarkTables(csvPath);
+            break;
+
+        case 6:
+            benchmarkInsertLatency(csvPath);
+            break;
+
+        case 7:
+            compareHashPolicies(csvPath);
+            break;
+
+        case 8:
+            benchmarkConcurrentTable(csvPath);
+            cout << "Stress test:" << endl;
+            stressConcurrentTable();
+            break;
         }
     }
 